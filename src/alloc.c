@@ -443,6 +443,7 @@ free_all_mem(void)
     free_tag_stuff();
     free_xim_stuff();
     free_cd_dir();
+    vcol_cache_clear();
 # ifdef FEAT_SIGNS
     free_signs();
 # endif
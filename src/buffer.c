@@ -929,6 +929,7 @@ buf_freeall(buf_T *buf, int flags)
 	// free the memory allocated for undo
 	// and reset all undo information
 	u_clearallandblockfree(buf);
+    search_count_clear(buf);	    // free the search count index
 #ifdef FEAT_SYN_HL
     syntax_clear(&buf->b_s);	    // reset syntax info
 #endif
@@ -2322,6 +2323,10 @@ buflist_new(
 #ifdef FEAT_SYN_HL
     hash_init(&buf->b_s.b_keywtab);
     hash_init(&buf->b_s.b_keywtab_ic);
+# ifdef FEAT_PROFILE
+    hash_init(&buf->b_s.b_syn_nest_time);
+    ga_init2(&buf->b_s.b_syn_line_time, sizeof(syn_line_time_T), 100);
+# endif
 #endif
 
     buf->b_fname = buf->b_sfname;
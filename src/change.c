@@ -467,10 +467,14 @@ changed_common(
     int		cols;
     pos_T	*p;
     int		add;
+    varnumber_T	old_tick = CHANGEDTICK(curbuf);
 
     // mark the buffer as modified
     changed();
 
+    // patch the search count index
+    search_count_changed(curbuf, lnum, lnume, xtra, old_tick);
+
 #ifdef FEAT_EVAL
     may_record_change(lnum, col, lnume, xtra);
 #endif
@@ -559,6 +563,13 @@ changed_common(
 	    if (!redraw_not_allowed && wp->w_redr_type < UPD_VALID)
 		wp->w_redr_type = UPD_VALID;
 
+#ifdef FEAT_SEARCH_EXTRA
+	    // Drop cached match results for the changed lines.
+	    match_cache_changed(wp, lnum, lnume, xtra, old_tick);
+#endif
+	    // Drop cached screen line counts for the changed lines.
+	    plines_cache_changed(wp, lnum, lnume, xtra, old_tick);
+
 	    // When inserting/deleting lines and the window has specific lines
 	    // to be redrawn, w_redraw_top and w_redraw_bot may now be invalid,
 	    // so just redraw everything.
@@ -580,21 +591,28 @@ changed_common(
 	    // Check if a change in the buffer has invalidated the cached
 	    // values for the cursor.
 #ifdef FEAT_FOLDING
-	    // Update the folds for this window.  Can't postpone this, because
-	    // a following operator might work on the whole fold: ">>dd".
-	    foldUpdate(wp, lnum, last);
-
-	    // The change may cause lines above or below the change to become
-	    // included in a fold.  Set lnum/lnume to the first/last line that
-	    // might be displayed differently.
-	    // Set w_cline_folded here as an efficient way to update it when
-	    // inserting lines just above a closed fold.
-	    i = hasFoldingWin(wp, lnum, &lnum, NULL, FALSE, NULL);
-	    if (wp->w_cursor.lnum == lnum)
-		wp->w_cline_folded = i;
-	    i = hasFoldingWin(wp, last, NULL, &last, FALSE, NULL);
-	    if (wp->w_cursor.lnum == last)
-		wp->w_cline_folded = i;
+	    if (fold_paste_busy > 0)
+		// Pasting in Insert mode: update the folds once when done.
+		foldPasteUpdate(wp, lnum, last);
+	    else
+	    {
+		// Update the folds for this window.  Can't postpone this,
+		// because a following operator might work on the whole fold:
+		// ">>dd".
+		foldUpdate(wp, lnum, last);
+
+		// The change may cause lines above or below the change to
+		// become included in a fold.  Set lnum/lnume to the first/last
+		// line that might be displayed differently.
+		// Set w_cline_folded here as an efficient way to update it
+		// when inserting lines just above a closed fold.
+		i = hasFoldingWin(wp, lnum, &lnum, NULL, FALSE, NULL);
+		if (wp->w_cursor.lnum == lnum)
+		    wp->w_cline_folded = i;
+		i = hasFoldingWin(wp, last, NULL, &last, FALSE, NULL);
+		if (wp->w_cursor.lnum == last)
+		    wp->w_cline_folded = i;
+	    }
 
 	    // If the changed line is in a range of previously folded lines,
 	    // compare with the first line in that range.
@@ -657,7 +675,7 @@ changed_common(
 #ifdef FEAT_FOLDING
 	    // Take care of side effects for setting w_topline when folds have
 	    // changed.  Esp. when the buffer was changed in another window.
-	    if (hasAnyFolding(wp))
+	    if (fold_paste_busy == 0 && hasAnyFolding(wp))
 		set_topline(wp, wp->w_topline);
 #endif
 	    // If lines have been added or removed, relative numbering always
@@ -35,7 +35,11 @@ static char_u	g_chartab[256];
 #define CT_ID_CHAR	0x20	// flag: set for ID chars
 #define CT_FNAME_CHAR	0x40	// flag: set for file name chars
 
+// In a long line getvcol() remembers the virtual column every this many bytes.
+#define VCOL_CACHE_STEP	1024
+
 static int in_win_border(win_T *wp, colnr_T vcol);
+static int chartabsize_simple(chartabsize_T *cts);
 
 /*
  * Fill g_chartab[].  Also fills curbuf->b_chartab[] with flags for keyword
@@ -80,9 +84,24 @@ buf_init_chartab(
     int		i;
     int		tilde;
     int		do_isalpha;
+    buf_T	*b;
+#ifdef FEAT_SEARCH_EXTRA
+    tabpage_T	*tp;
+    win_T	*wp;
+#endif
 
     if (global)
     {
+	// The size of characters may change.
+	vcol_cache_clear();
+	// What "\i", "\f" and "\p" match may change.
+	FOR_ALL_BUFFERS(b)
+	    search_count_clear(b);
+#ifdef FEAT_SEARCH_EXTRA
+	FOR_ALL_TAB_WINDOWS(tp, wp)
+	    match_cache_clear(wp);
+#endif
+
 	/*
 	 * Set the default size for printable characters:
 	 * From <Space> to '~' is 1 (printable), others are 2 (not printable).
@@ -806,8 +825,37 @@ win_linetabsize(win_T *wp, linenr_T lnum, char_u *line, colnr_T len)
   int
 linetabsize(win_T *wp, linenr_T lnum)
 {
-    return win_linetabsize(wp, lnum,
-		       ml_get_buf(wp->w_buffer, lnum, FALSE), (colnr_T)MAXCOL);
+    chartabsize_T cts;
+    char_u	*line = ml_get_buf(wp->w_buffer, lnum, FALSE);
+
+    init_chartabsize_arg(&cts, wp, lnum, 0, line, line);
+    if (!linetabsize_cached(&cts, lnum))
+	win_linetabsize_cts(&cts, (colnr_T)MAXCOL);
+    clear_chartabsize_arg(&cts);
+    return (int)cts.cts_vcol;
+}
+
+/*
+ * When line "lnum" is long and its virtual columns can be cached, set
+ * "cts->cts_vcol" to the number of cells the whole line takes and return
+ * TRUE.  See getvcol().  "cts" must be initialized for line "lnum" of the
+ * buffer of "cts_win", starting at column zero.
+ */
+    int
+linetabsize_cached(chartabsize_T *cts, linenr_T lnum)
+{
+    pos_T	pos;
+
+    if (lnum <= 0 || cts->cts_vcol != 0 || cts->cts_ptr != cts->cts_line
+						   || !chartabsize_simple(cts))
+	return FALSE;
+    pos.col = ml_get_buf_len(cts->cts_win->w_buffer, lnum);
+    if (pos.col < VCOL_CACHE_STEP)
+	return FALSE;
+    pos.lnum = lnum;
+    pos.coladd = 0;
+    getvcol(cts->cts_win, &pos, &cts->cts_vcol, NULL, NULL);
+    return TRUE;
 }
 
 /*
@@ -1539,6 +1587,159 @@ in_win_border(win_T *wp, colnr_T vcol)
     return ((vcol - width1) % width2 == width2 - 1);
 }
 
+/*
+ * Return TRUE when the size of a character in the line of "cts" only depends
+ * on the character and the virtual column it is at: 'list' (unless tabs take
+ * their normal size), 'linebreak', 'showbreak' and 'breakindent' are not set
+ * and there are no text properties with "text".
+ */
+    static int
+chartabsize_simple(chartabsize_T *cts)
+{
+    win_T	*wp = cts->cts_win;
+
+    return (!wp->w_p_list || wp->w_lcs_chars.tab1 != NUL)
+#ifdef FEAT_LINEBREAK
+	    && !wp->w_p_lbr && *get_showbreak_value(wp) == NUL && !wp->w_p_bri
+#endif
+#ifdef FEAT_PROP_POPUP
+	    && !cts->cts_has_prop_with_text
+#endif
+	    ;
+}
+
+/*
+ * Cache of virtual columns in a long line, so that getvcol() does not need to
+ * go over the whole line each time the cursor moves in it.  The virtual
+ * column is remembered every VCOL_CACHE_STEP bytes.  Only used when the size
+ * of a character depends on nothing else than the character and the virtual
+ * column it is at, and 'vartabstop' is not set.
+ */
+typedef struct
+{
+    colnr_T	vp_col;		// byte index of a character
+    colnr_T	vp_vcol;	// virtual column of that character
+} vcolpoint_T;
+
+static struct
+{
+    int		vc_fnum;	// buffer number, zero when not valid
+    linenr_T	vc_lnum;	// line number in the buffer
+    varnumber_T	vc_changedtick;	// b:changedtick of the buffer
+    colnr_T	vc_len;		// length of the line
+    int		vc_ts;		// 'tabstop'
+    int		vc_width;	// window width when wrapping, for in_win_border()
+    int		vc_col_off;	// win_col_off() when wrapping
+    int		vc_col_off2;	// win_col_off2() when wrapping
+    garray_T	vc_points;	// vcolpoint_T items, increasing vp_col
+} vcol_cache;
+
+/*
+ * Invalidate the cache used by getvcol().  To be called when the size of
+ * characters may have changed, e.g. when 'ambiwidth' was set.
+ */
+    void
+vcol_cache_clear(void)
+{
+    vcol_cache.vc_fnum = 0;
+    ga_clear(&vcol_cache.vc_points);
+}
+
+/*
+ * Prepare the vcol cache to be used for line "lnum" in window "wp".  Clears
+ * the cache when it was for another line, or the line or the options that
+ * matter have changed.  When "reset" is FALSE return FALSE then instead.
+ * Returns FALSE when the cache cannot be used.
+ */
+    static int
+vcol_cache_use(win_T *wp, linenr_T lnum, colnr_T len, int reset)
+{
+    buf_T	*buf = wp->w_buffer;
+    int		width = 0;
+    int		col_off = 0;
+    int		col_off2 = 0;
+
+#ifdef FEAT_VARTABS
+    if (buf->b_p_vts_array != NULL && buf->b_p_vts_array[0] > 0)
+	return FALSE;
+#endif
+    if (has_mbyte && wp->w_p_wrap && wp->w_width > 0)
+    {
+	width = wp->w_width;
+	col_off = win_col_off(wp);
+	col_off2 = win_col_off2(wp);
+    }
+
+    if (vcol_cache.vc_fnum != buf->b_fnum
+	    || vcol_cache.vc_lnum != lnum
+	    || vcol_cache.vc_changedtick != CHANGEDTICK(buf)
+	    || vcol_cache.vc_len != len
+	    || vcol_cache.vc_ts != buf->b_p_ts
+	    || vcol_cache.vc_width != width
+	    || vcol_cache.vc_col_off != col_off
+	    || vcol_cache.vc_col_off2 != col_off2)
+    {
+	if (!reset)
+	    return FALSE;
+	vcol_cache.vc_fnum = buf->b_fnum;
+	vcol_cache.vc_lnum = lnum;
+	vcol_cache.vc_changedtick = CHANGEDTICK(buf);
+	vcol_cache.vc_len = len;
+	vcol_cache.vc_ts = buf->b_p_ts;
+	vcol_cache.vc_width = width;
+	vcol_cache.vc_col_off = col_off;
+	vcol_cache.vc_col_off2 = col_off2;
+	if (vcol_cache.vc_points.ga_itemsize == 0)
+	    ga_init2(&vcol_cache.vc_points, sizeof(vcolpoint_T), 100);
+	vcol_cache.vc_points.ga_len = 0;
+    }
+    return TRUE;
+}
+
+/*
+ * Find the last cached position at or before byte index "col".
+ * Returns the byte index and sets "*vcolp" to its virtual column.  Returns
+ * zero when there is none.
+ */
+    static colnr_T
+vcol_cache_find(colnr_T col, colnr_T *vcolp)
+{
+    vcolpoint_T	*vp = (vcolpoint_T *)vcol_cache.vc_points.ga_data;
+    int		lo = 0;
+    int		hi = vcol_cache.vc_points.ga_len - 1;
+    int		mid;
+
+    if (hi < 0 || vp[0].vp_col > col)
+	return 0;
+    while (lo < hi)
+    {
+	mid = (lo + hi + 1) / 2;
+	if (vp[mid].vp_col <= col)
+	    lo = mid;
+	else
+	    hi = mid - 1;
+    }
+    *vcolp = vp[lo].vp_vcol;
+    return vp[lo].vp_col;
+}
+
+/*
+ * Add byte index "col" with virtual column "vcol" to the vcol cache.
+ */
+    static int
+vcol_cache_add(colnr_T col, colnr_T vcol)
+{
+    vcolpoint_T	*vp;
+
+    if (ga_grow(&vcol_cache.vc_points, 1) == FAIL)
+	return FAIL;
+    vp = (vcolpoint_T *)vcol_cache.vc_points.ga_data
+					       + vcol_cache.vc_points.ga_len++;
+    vp->vp_col = col;
+    vp->vp_vcol = vcol;
+    return OK;
+}
+
 /*
  * Get virtual column number of pos.
  *  start: on the first position of this character (TAB, ctrl)
@@ -1582,15 +1783,19 @@ getvcol(
      * and there are no text properties with "text" use a simple loop.
      * Also use this when 'list' is set but tabs take their normal size.
      */
-    if ((!wp->w_p_list || wp->w_lcs_chars.tab1 != NUL)
-#ifdef FEAT_LINEBREAK
-	    && !wp->w_p_lbr && *get_showbreak_value(wp) == NUL && !wp->w_p_bri
-#endif
-#ifdef FEAT_PROP_POPUP
-	    && !cts.cts_has_prop_with_text
-#endif
-       )
+    if (chartabsize_simple(&cts))
     {
+	colnr_T	next_point = MAXCOL;	// byte index of the next cache point
+
+	// In a long line start at a cached position.  Cache points are at the
+	// first character at or after each multiple of VCOL_CACHE_STEP.
+	if (pos->col >= VCOL_CACHE_STEP && vcol_cache_use(wp, pos->lnum,
+				ml_get_buf_len(wp->w_buffer, pos->lnum), TRUE))
+	{
+	    ptr = line + vcol_cache_find(pos->col, &vcol);
+	    next_point = (vcol_cache.vc_points.ga_len + 1) * VCOL_CACHE_STEP;
+	}
+
 	for (;;)
 	{
 	    head = 0;
@@ -1639,6 +1844,14 @@ getvcol(
 
 	    vcol += incr;
 	    ptr = next_ptr;
+
+	    if (ptr - line >= next_point)
+	    {
+		if (vcol_cache_add((colnr_T)(ptr - line), vcol) == OK)
+		    next_point += VCOL_CACHE_STEP;
+		else
+		    next_point = MAXCOL;
+	    }
 	}
     }
     else
@@ -1709,6 +1922,77 @@ getvcol(
     }
 }
 
+/*
+ * For a long line "lnum" in window "wp" find a character before virtual
+ * column "vcol" in the vcol cache, see getvcol().  Only when the cache is
+ * already for this line, e.g. because the cursor is in it.  Adds cached
+ * positions up to "vcol" when needed, not for the rest of the line.
+ * Returns the byte index of the character and sets "*vcolp" to its virtual
+ * column.  Returns zero when there is none or the cache cannot be used.
+ */
+    colnr_T
+getvcol_before(win_T *wp, linenr_T lnum, colnr_T vcol, colnr_T *vcolp)
+{
+    char_u	*line;
+    colnr_T	len;
+    int		simple;
+    vcolpoint_T	*vp;
+    int		lo;
+    int		hi;
+    int		mid;
+    pos_T	pos;
+    chartabsize_T cts;
+
+    // Going over the first part of the line is fast enough.
+    if (vcol < VCOL_CACHE_STEP)
+	return 0;
+    len = ml_get_buf_len(wp->w_buffer, lnum);
+    if (len < VCOL_CACHE_STEP)
+	return 0;
+    line = ml_get_buf(wp->w_buffer, lnum, FALSE);
+    init_chartabsize_arg(&cts, wp, lnum, 0, line, line);
+    simple = chartabsize_simple(&cts);
+    clear_chartabsize_arg(&cts);
+    if (!simple || !vcol_cache_use(wp, lnum, len, FALSE))
+	return 0;
+
+    // When the cached positions do not go up to "vcol" yet, add them one at
+    // a time until there is one at or after "vcol".  getvcol() starts at the
+    // last cached position and adds the next one.
+    pos.lnum = lnum;
+    pos.coladd = 0;
+    for (;;)
+    {
+	vp = (vcolpoint_T *)vcol_cache.vc_points.ga_data;
+	hi = vcol_cache.vc_points.ga_len - 1;
+	if ((hi >= 0 && vp[hi].vp_vcol >= vcol)
+				   || (hi + 2) * VCOL_CACHE_STEP >= len)
+	    break;
+	// Go a few bytes further, a multibyte character may be at the
+	// position.
+	pos.col = (hi + 2) * VCOL_CACHE_STEP + MB_MAXBYTES;
+	if (pos.col > len)
+	    pos.col = len;
+	getvcol(wp, &pos, NULL, NULL, NULL);
+	if (vcol_cache.vc_points.ga_len <= hi + 1)
+	    break;
+    }
+
+    if (hi < 0 || vp[0].vp_vcol >= vcol)
+	return 0;
+    lo = 0;
+    while (lo < hi)
+    {
+	mid = (lo + hi + 1) / 2;
+	if (vp[mid].vp_vcol < vcol)
+	    lo = mid;
+	else
+	    hi = mid - 1;
+    }
+    *vcolp = vp[lo].vp_vcol;
+    return vp[lo].vp_col;
+}
+
 /*
  * Get virtual cursor column in the current window, pretending 'list' is off.
  */
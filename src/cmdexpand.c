@@ -2460,6 +2460,10 @@ set_context_by_cmdname(
 	    xp->xp_context = EXPAND_SYNTIME;
 	    xp->xp_pattern = arg;
 	    break;
+	case CMD_drawtime:
+	    xp->xp_context = EXPAND_DRAWTIME;
+	    xp->xp_pattern = arg;
+	    break;
 #endif
 
 	case CMD_argdelete:
@@ -3011,6 +3015,7 @@ ExpandOther(
 #endif
 #ifdef FEAT_PROFILE
 	{EXPAND_SYNTIME, get_syntime_arg, TRUE, TRUE},
+	{EXPAND_DRAWTIME, get_drawtime_arg, TRUE, TRUE},
 #endif
 	{EXPAND_HIGHLIGHT, get_highlight_name, TRUE, TRUE},
 	{EXPAND_EVENTS, get_event_name, TRUE, FALSE},
@@ -1177,6 +1177,9 @@ win_line(
     int		prev_syntax_attr = 0;	// syntax_attr at prev_syntax_col
     int		has_syntax = FALSE;	// this buffer has syntax highl.
     int		save_did_emsg;
+# ifdef FEAT_PROFILE
+    proftime_T	dt_tm;			// for measuring ":drawtime"
+# endif
 #endif
 #ifdef FEAT_PROP_POPUP
     int		did_line = FALSE;	// set to TRUE when line text done
@@ -1313,7 +1316,15 @@ win_line(
 	    // error, stop syntax highlighting.
 	    save_did_emsg = did_emsg;
 	    did_emsg = FALSE;
+# ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		profile_start(&dt_tm);
+# endif
 	    syntax_start(wp, lnum);
+# ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		drawtime_add(DRAWTIME_SYNTAX, &dt_tm);
+# endif
 	    if (did_emsg)
 		wp->w_s->b_syn_error = TRUE;
 	    else
@@ -1720,6 +1731,22 @@ win_line(
 
 	init_chartabsize_arg(&cts, wp, lnum, wlv.vcol, line, ptr);
 	cts.cts_max_head_vcol = v;
+
+	// In a long line continue from a cached position before "v", instead
+	// of going over all the text that is not displayed.  Not with 'list',
+	// counting multispace needs all the characters.
+	if (ptr == line && wlv.vcol == 0 && !wp->w_p_list)
+	{
+	    colnr_T	vcol_before;
+	    colnr_T	col_before = getvcol_before(wp, lnum, v, &vcol_before);
+
+	    if (col_before > 0)
+	    {
+		cts.cts_ptr = line + col_before;
+		cts.cts_vcol = vcol_before;
+	    }
+	}
+
 	while (cts.cts_vcol < v && *cts.cts_ptr != NUL)
 	{
 	    head = 0;
@@ -2455,12 +2482,20 @@ win_line(
 		    {
 # ifdef FEAT_SPELL
 			can_spell = TRUE;
+# endif
+# ifdef FEAT_PROFILE
+			if (drawtime_active)
+			    profile_start(&dt_tm);
 # endif
 			syntax_attr = get_syntax_attr((colnr_T)v,
 # ifdef FEAT_SPELL
 					    spv->spv_has_spell ? &can_spell :
 # endif
 					    NULL, FALSE);
+# ifdef FEAT_PROFILE
+			if (drawtime_active)
+			    drawtime_add(DRAWTIME_SYNTAX, &dt_tm);
+# endif
 			prev_syntax_col = v;
 			prev_syntax_attr = syntax_attr;
 		    }
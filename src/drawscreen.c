@@ -69,6 +69,10 @@ static void win_update(win_T *wp);
 #ifdef FEAT_STL_OPT
 static void redraw_custom_statusline(win_T *wp);
 #endif
+#ifdef FEAT_PROFILE
+static void drawtime_start(proftime_T *tm);
+static void drawtime_end(proftime_T *tm);
+#endif
 #if defined(FEAT_SEARCH_EXTRA) || defined(FEAT_CLIPBOARD)
 static int  did_update_one_window;
 #endif
@@ -92,6 +96,10 @@ update_screen(int type_arg)
 #endif
     int		no_update = FALSE;
     int		save_pum_will_redraw = pum_will_redraw;
+#ifdef FEAT_PROFILE
+    proftime_T	dt_total;
+    proftime_T	dt_tm;
+#endif
 
     // Don't do anything if the screen structures are (not yet) valid.
     if (!screen_valid(TRUE))
@@ -150,6 +158,12 @@ update_screen(int type_arg)
 	return FAIL;
     }
     updating_screen = TRUE;
+#ifdef FEAT_PROFILE
+    drawtime_start(&dt_total);
+#endif
+
+    // Collect the output, so that the terminal gets the update at once.
+    out_batch_start();
 
 #ifdef FEAT_PROP_POPUP
     // Update popup_mask if needed.  This may set w_redraw_top and w_redraw_bot
@@ -263,7 +277,17 @@ update_screen(int type_arg)
 
     // Redraw the tab pages line if needed.
     if (redraw_tabline || type >= UPD_NOT_VALID)
+    {
+#ifdef FEAT_PROFILE
+	if (drawtime_active)
+	    profile_start(&dt_tm);
+#endif
 	draw_tabline();
+#ifdef FEAT_PROFILE
+	if (drawtime_active)
+	    drawtime_add(DRAWTIME_STATUS, &dt_tm);
+#endif
+    }
 
 #ifdef FEAT_SYN_HL
     // Correct stored syntax highlighting info for changes in each displayed
@@ -320,15 +344,31 @@ update_screen(int type_arg)
 		    did_undraw = TRUE;
 		}
 	    }
+#endif
+#ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		profile_start(&dt_tm);
 #endif
 	    win_update(wp);
+#ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		drawtime_add(DRAWTIME_TEXT, &dt_tm);
+#endif
 	}
 
 	// redraw status line after the window to minimize cursor movement
 	if (wp->w_redr_status)
 	{
 	    cursor_off();
+#ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		profile_start(&dt_tm);
+#endif
 	    win_redr_status(wp, TRUE); // any popup menu will be redrawn below
+#ifdef FEAT_PROFILE
+	    if (drawtime_active)
+		drawtime_add(DRAWTIME_STATUS, &dt_tm);
+#endif
 	}
     }
 #if defined(FEAT_SEARCH_EXTRA)
@@ -337,7 +377,15 @@ update_screen(int type_arg)
 
     // May need to redraw the popup menu.
     pum_will_redraw = save_pum_will_redraw;
+#ifdef FEAT_PROFILE
+    if (drawtime_active)
+	profile_start(&dt_tm);
+#endif
     pum_may_redraw();
+#ifdef FEAT_PROFILE
+    if (drawtime_active)
+	drawtime_add(DRAWTIME_POPUPS, &dt_tm);
+#endif
 
     // Reset b_mod_set flags.  Going through all windows is probably faster
     // than going through all buffers (there could be many buffers).
@@ -346,7 +394,15 @@ update_screen(int type_arg)
 
 #ifdef FEAT_PROP_POPUP
     // Display popup windows on top of the windows and command line.
+# ifdef FEAT_PROFILE
+    if (drawtime_active)
+	profile_start(&dt_tm);
+# endif
     update_popups(win_update);
+# ifdef FEAT_PROFILE
+    if (drawtime_active)
+	drawtime_add(DRAWTIME_POPUPS, &dt_tm);
+# endif
 #endif
 
 #ifdef FEAT_TERMINAL
@@ -371,6 +427,8 @@ update_screen(int type_arg)
 	maybe_intro_message();
     did_intro = TRUE;
 
+    out_batch_end();
+
 #ifdef FEAT_GUI
     // Redraw the cursor and update the scrollbars when all screen updating is
     // done.
@@ -396,6 +454,9 @@ update_screen(int type_arg)
 	    out_flush();
 	gui_update_scrollbars(FALSE);
     }
+#endif
+#ifdef FEAT_PROFILE
+    drawtime_end(&dt_total);
 #endif
     return OK;
 }
@@ -2193,6 +2254,11 @@ win_update(win_T *wp)
     }
 #endif
 
+    // When all rows are going to be drawn, text that moved up may be scrolled
+    // instead, see screen_line().
+    if (mid_start == 0 && mid_end >= wp->w_height && bot_start >= 999)
+	win_rowhash_start(wp);
+
     // Update all the window rows.
     idx = 0;		// first entry in w_lines[].wl_size
     row = 0;
@@ -2492,6 +2558,10 @@ win_update(win_T *wp)
 
 		// Display one line.
 		row = win_line(wp, lnum, srow, wp->w_height, 0, &spv);
+#ifdef FEAT_PROFILE
+		if (drawtime_active)
+		    drawtime_add_lines(wp, 1L);
+#endif
 
 #ifdef FEAT_FOLDING
 		wp->w_lines[idx].wl_folded = FALSE;
@@ -2577,6 +2647,7 @@ win_update(win_T *wp)
     }
 
     // End of loop over all window lines.
+    win_rowhash_end();
 
 #ifdef FEAT_SYN_HL
     // Now that the window has been redrawn with the old and new cursor line,
@@ -3165,6 +3236,13 @@ redraw_win_later(
 	wp->w_redr_type = type;
 	if (type >= UPD_NOT_VALID)
 	    wp->w_lines_valid = 0;
+#ifdef FEAT_PROP_POPUP
+	// A popup window is drawn on top of the other windows, redrawing it
+	// does not require redrawing them.  What is uncovered is found by
+	// comparing the popup mask.
+	if (WIN_IS_POPUP(wp) && type > UPD_VALID)
+	    type = UPD_VALID;
+#endif
 	if (must_redraw < type)	// must_redraw is the maximum of all windows
 	    must_redraw = type;
     }
@@ -3368,3 +3446,396 @@ redrawWinline(
 	wp->w_redraw_bot = lnum;
     redraw_win_later(wp, UPD_VALID);
 }
+
+#if defined(FEAT_PROFILE) || defined(PROTO)
+// Number of screen updates kept for ":drawtime report" and getdrawtime().
+# define DRAWTIME_FRAMES	100
+
+// Number of buckets in the histogram of screen update times.  Bucket "n" is
+// for times less than 2^n msec, the last one for anything longer.
+# define DRAWTIME_BUCKETS	10
+
+static char *drawtime_names[DRAWTIME_COUNT] =
+    {"text", "syntax", "folds", "status", "popups", "output"};
+
+/*
+ * Time spent on one screen update, or on all of them.
+ */
+typedef struct
+{
+    proftime_T	df_total;			// time in update_screen()
+    proftime_T	df_phase[DRAWTIME_COUNT];	// time for each phase
+    long	df_lines;			// nr of buffer lines drawn
+} drawframe_T;
+
+static int	    drawtime_on = FALSE;	// ":drawtime on" was used
+static drawframe_T  drawtime_frames[DRAWTIME_FRAMES]; // last screen updates
+static int	    drawtime_frames_len = 0;	// used entries
+static int	    drawtime_frames_idx = 0;	// index of the current one
+static drawframe_T  drawtime_total;		// all screen updates
+static proftime_T   drawtime_slowest;		// slowest screen update
+static long	    drawtime_count = 0;		// nr of screen updates
+
+/*
+ * Write the times of the current screen update to the log file, if there is
+ * one.
+ */
+    static void
+drawtime_log(void)
+{
+# ifdef FEAT_EVAL
+    drawframe_T	*frame = &drawtime_frames[drawtime_frames_idx];
+
+    if (ch_log_active())
+	ch_log(NULL, "drawtime: total %.6f text %.6f syntax %.6f folds %.6f "
+				"status %.6f popups %.6f output %.6f lines %ld",
+		profile_float(&frame->df_total),
+		profile_float(&frame->df_phase[DRAWTIME_TEXT]),
+		profile_float(&frame->df_phase[DRAWTIME_SYNTAX]),
+		profile_float(&frame->df_phase[DRAWTIME_FOLDS]),
+		profile_float(&frame->df_phase[DRAWTIME_STATUS]),
+		profile_float(&frame->df_phase[DRAWTIME_POPUPS]),
+		profile_float(&frame->df_phase[DRAWTIME_OUTPUT]),
+		frame->df_lines);
+# endif
+}
+
+/*
+ * Start measuring a screen update, if ":drawtime on" was used.  "tm" is set
+ * to the start time.
+ */
+    static void
+drawtime_start(proftime_T *tm)
+{
+    drawframe_T	*frame;
+    int		i;
+
+    if (!drawtime_on)
+	return;
+    // The output of the previous update was not written yet, log it now.
+    if (drawtime_output && drawtime_frames_len > 0)
+	drawtime_log();
+
+    drawtime_frames_idx = drawtime_frames_len == 0 ? 0
+				  : (drawtime_frames_idx + 1) % DRAWTIME_FRAMES;
+    if (drawtime_frames_len < DRAWTIME_FRAMES)
+	++drawtime_frames_len;
+    frame = &drawtime_frames[drawtime_frames_idx];
+    profile_zero(&frame->df_total);
+    for (i = 0; i < DRAWTIME_COUNT; ++i)
+	profile_zero(&frame->df_phase[i]);
+    frame->df_lines = 0;
+
+    drawtime_active = TRUE;
+    drawtime_output = TRUE;
+    profile_start(tm);
+}
+
+/*
+ * Finish measuring a screen update started at "tm".
+ */
+    static void
+drawtime_end(proftime_T *tm)
+{
+    drawframe_T	*frame = &drawtime_frames[drawtime_frames_idx];
+
+    if (!drawtime_active)
+	return;
+    drawtime_active = FALSE;
+
+    profile_end(tm);
+    frame->df_total = *tm;
+    profile_add(&drawtime_total.df_total, tm);
+    if (profile_cmp(&drawtime_slowest, tm) > 0)
+	drawtime_slowest = *tm;
+    ++drawtime_count;
+    // Logged when the output has been written.
+}
+
+/*
+ * Add the time since "tm" to "phase" of the current screen update.  Only to
+ * be called when "drawtime_active" or "drawtime_output" is set.
+ */
+    void
+drawtime_add(int phase, proftime_T *tm)
+{
+    profile_end(tm);
+    profile_add(&drawtime_frames[drawtime_frames_idx].df_phase[phase], tm);
+    profile_add(&drawtime_total.df_phase[phase], tm);
+
+    // The output of a screen update is written with the first flush after
+    // it.
+    if (phase == DRAWTIME_OUTPUT && !drawtime_active)
+    {
+	drawtime_output = FALSE;
+	drawtime_log();
+    }
+}
+
+/*
+ * Add "count" buffer lines drawn in window "wp" to the current screen update.
+ */
+    void
+drawtime_add_lines(win_T *wp, long count)
+{
+    drawtime_frames[drawtime_frames_idx].df_lines += count;
+    drawtime_total.df_lines += count;
+    wp->w_drawtime_lines += count;
+}
+
+    static void
+drawtime_clear(void)
+{
+    tabpage_T	*tp;
+    win_T	*wp;
+    int		i;
+
+    drawtime_frames_len = 0;
+    drawtime_frames_idx = 0;
+    profile_zero(&drawtime_total.df_total);
+    for (i = 0; i < DRAWTIME_COUNT; ++i)
+	profile_zero(&drawtime_total.df_phase[i]);
+    drawtime_total.df_lines = 0;
+    profile_zero(&drawtime_slowest);
+    drawtime_count = 0;
+    drawtime_active = FALSE;
+    drawtime_output = FALSE;
+    FOR_ALL_TAB_WINDOWS(tp, wp)
+	wp->w_drawtime_lines = 0;
+}
+
+/*
+ * Fill "buckets" with the histogram of the kept screen update times.
+ */
+    static void
+drawtime_histogram(long *buckets)
+{
+    int		i;
+    int		b;
+    float_T	msec;
+
+    for (b = 0; b < DRAWTIME_BUCKETS; ++b)
+	buckets[b] = 0;
+    for (i = 0; i < drawtime_frames_len; ++i)
+    {
+	msec = profile_float(&drawtime_frames[i].df_total) * 1000.0;
+	for (b = 0; b < DRAWTIME_BUCKETS - 1; ++b)
+	    if (msec < (float_T)(1 << b))
+		break;
+	++buckets[b];
+    }
+}
+
+/*
+ * ":drawtime report": list the time spent on the phases of screen updates,
+ * the lines drawn in each window and a histogram of the last screen updates.
+ */
+    static void
+drawtime_report(void)
+{
+    proftime_T	tm;
+    long	buckets[DRAWTIME_BUCKETS];
+    int		i;
+    win_T	*wp;
+    char	buf[50];
+
+    if (drawtime_count == 0)
+    {
+	msg(_("No screen updates measured"));
+	return;
+    }
+
+    msg_puts_title(_("  TOTAL      COUNT  SLOWEST     AVERAGE     LINES"));
+    msg_puts("\n");
+    msg_puts(profile_msg(&drawtime_total.df_total));
+    msg_puts(" ");
+    msg_advance(13);
+    msg_outnum(drawtime_count);
+    msg_puts(" ");
+    msg_advance(20);
+    msg_puts(profile_msg(&drawtime_slowest));
+    msg_puts(" ");
+    msg_advance(32);
+    profile_divide(&drawtime_total.df_total, (int)drawtime_count, &tm);
+    msg_puts(profile_msg(&tm));
+    msg_puts(" ");
+    msg_advance(44);
+    msg_outnum(drawtime_total.df_lines);
+    msg_puts("\n\n");
+
+    msg_puts_title(_("  TOTAL      AVERAGE     PHASE"));
+    for (i = 0; i < DRAWTIME_COUNT && !got_int; ++i)
+    {
+	msg_puts("\n");
+	msg_puts(profile_msg(&drawtime_total.df_phase[i]));
+	msg_puts(" ");
+	msg_advance(13);
+	profile_divide(&drawtime_total.df_phase[i], (int)drawtime_count, &tm);
+	msg_puts(profile_msg(&tm));
+	msg_puts(" ");
+	msg_advance(25);
+	msg_puts(drawtime_names[i]);
+    }
+    msg_puts("\n\n");
+
+    msg_puts_title(_("  LINES  WINDOW"));
+    FOR_ALL_WINDOWS(wp)
+    {
+	if (got_int)
+	    break;
+	msg_puts("\n");
+	msg_advance(2);
+	msg_outnum(wp->w_drawtime_lines);
+	msg_puts(" ");
+	msg_advance(9);
+	msg_outnum(wp->w_id);
+	msg_puts(" ");
+	msg_outtrans(wp->w_buffer->b_fname == NULL ? (char_u *)_("[No Name]")
+						    : wp->w_buffer->b_fname);
+    }
+    msg_puts("\n\n");
+
+    msg_puts_title(_("  COUNT  TIME"));
+    drawtime_histogram(buckets);
+    for (i = 0; i < DRAWTIME_BUCKETS && !got_int; ++i)
+    {
+	msg_puts("\n");
+	msg_advance(2);
+	msg_outnum(buckets[i]);
+	msg_puts(" ");
+	msg_advance(9);
+	if (i < DRAWTIME_BUCKETS - 1)
+	    vim_snprintf(buf, sizeof(buf), "< %d msec", 1 << i);
+	else
+	    vim_snprintf(buf, sizeof(buf), ">= %d msec", 1 << (i - 1));
+	msg_puts(buf);
+    }
+    msg_puts("\n");
+}
+
+/*
+ * ":drawtime {on,off,clear,report}".
+ */
+    void
+ex_drawtime(exarg_T *eap)
+{
+    if (STRCMP(eap->arg, "on") == 0)
+	drawtime_on = TRUE;
+    else if (STRCMP(eap->arg, "off") == 0)
+	drawtime_on = FALSE;
+    else if (STRCMP(eap->arg, "clear") == 0)
+	drawtime_clear();
+    else if (STRCMP(eap->arg, "report") == 0)
+	drawtime_report();
+    else
+	semsg(_(e_invalid_argument_str), eap->arg);
+}
+
+/*
+ * Function given to ExpandGeneric() to obtain the possible arguments of the
+ * ":drawtime {on,off,clear,report}" command.
+ */
+    char_u *
+get_drawtime_arg(expand_T *xp UNUSED, int idx)
+{
+    switch (idx)
+    {
+	case 0: return (char_u *)"on";
+	case 1: return (char_u *)"off";
+	case 2: return (char_u *)"clear";
+	case 3: return (char_u *)"report";
+    }
+    return NULL;
+}
+
+# if defined(FEAT_EVAL) || defined(PROTO)
+/*
+ * Add the times of "frame" to dictionary "d".
+ */
+    static void
+drawtime_dict_add(dict_T *d, drawframe_T *frame)
+{
+    typval_T	tv;
+    int		i;
+
+    tv.v_type = VAR_FLOAT;
+    tv.v_lock = 0;
+    tv.vval.v_float = profile_float(&frame->df_total);
+    dict_add_tv(d, "total", &tv);
+    for (i = 0; i < DRAWTIME_COUNT; ++i)
+    {
+	tv.vval.v_float = profile_float(&frame->df_phase[i]);
+	dict_add_tv(d, drawtime_names[i], &tv);
+    }
+    dict_add_number(d, "lines", frame->df_lines);
+}
+# endif
+#endif
+
+#if defined(FEAT_EVAL) || defined(PROTO)
+/*
+ * "getdrawtime()" function
+ */
+    void
+f_getdrawtime(typval_T *argvars UNUSED, typval_T *rettv)
+{
+# ifdef FEAT_PROFILE
+    dict_T	*d;
+    dict_T	*dw;
+    list_T	*l;
+    long	buckets[DRAWTIME_BUCKETS];
+    typval_T	tv;
+    win_T	*wp;
+    int		i;
+    char	buf[NUMBUFLEN];
+# endif
+
+    if (rettv_dict_alloc(rettv) == FAIL)
+	return;
+# ifdef FEAT_PROFILE
+    d = rettv->vval.v_dict;
+    dict_add_number(d, "count", drawtime_count);
+    drawtime_dict_add(d, &drawtime_total);
+    tv.v_type = VAR_FLOAT;
+    tv.v_lock = 0;
+    tv.vval.v_float = profile_float(&drawtime_slowest);
+    dict_add_tv(d, "slowest", &tv);
+
+    // Lines drawn in each window, by window ID.
+    dw = dict_alloc();
+    if (dw == NULL)
+	return;
+    FOR_ALL_WINDOWS(wp)
+    {
+	vim_snprintf(buf, sizeof(buf), "%d", wp->w_id);
+	dict_add_number(dw, buf, wp->w_drawtime_lines);
+    }
+    dict_add_dict(d, "windows", dw);
+
+    // The last screen updates, oldest first.
+    l = list_alloc();
+    if (l == NULL)
+	return;
+    for (i = 0; i < drawtime_frames_len; ++i)
+    {
+	dict_T	*df = dict_alloc();
+
+	if (df == NULL)
+	    break;
+	drawtime_dict_add(df, &drawtime_frames[(drawtime_frames_idx + 1 + i
+			  + DRAWTIME_FRAMES - drawtime_frames_len)
+							   % DRAWTIME_FRAMES]);
+	list_append_dict(l, df);
+    }
+    dict_add_list(d, "frames", l);
+
+    l = list_alloc();
+    if (l == NULL)
+	return;
+    drawtime_histogram(buckets);
+    for (i = 0; i < DRAWTIME_BUCKETS; ++i)
+	list_append_number(l, buckets[i]);
+    dict_add_list(d, "histogram", l);
+# endif
+}
+#endif
@@ -4443,12 +4443,22 @@ bracketed_paste(paste_mode_T mode, int drop, garray_T *gap)
 	// Also have the side effects of setting 'paste' to make it work much
 	// faster.
 	set_option_value_give_err((char_u *)"paste", TRUE, NULL, 0);
+#ifdef FEAT_FOLDING
+    if (mode == PASTE_INSERT)
+	// Adjust and update the folds once for all pasted lines.
+	++fold_paste_busy;
+#endif
 
     for (;;)
     {
 	// When the end is not defined read everything there is.
 	if (end == NULL && vpeekc() == NUL)
 	    break;
+#ifdef FEAT_FOLDING
+	// Waiting for more text may invoke callbacks that use the folds.
+	if (fold_paste_busy > 0 && typebuf.tb_len == 0)
+	    foldPasteFlush();
+#endif
 	do
 	    c = vgetc();
 	while (c == K_IGNORE || c == K_VER_SCROLLBAR || c == K_HOR_SCROLLBAR);
@@ -4515,6 +4525,13 @@ bracketed_paste(paste_mode_T mode, int drop, garray_T *gap)
 	idx = 0;
     }
 
+#ifdef FEAT_FOLDING
+    if (mode == PASTE_INSERT)
+    {
+	foldPasteFlush();
+	--fold_paste_busy;
+    }
+#endif
     --no_mapping;
     allow_keys = save_allow_keys;
     if (!save_paste)
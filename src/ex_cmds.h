@@ -524,6 +524,9 @@ EXCMD(CMD_doautoall,	"doautoall",	ex_doautoall,
 EXCMD(CMD_drop,		"drop",		ex_drop,
 	EX_BANG|EX_FILES|EX_CMDARG|EX_NEEDARG|EX_ARGOPT|EX_TRLBAR,
 	ADDR_NONE),
+EXCMD(CMD_drawtime,	"drawtime",	ex_drawtime,
+	EX_NEEDARG|EX_WORD1|EX_TRLBAR|EX_CMDWIN|EX_LOCK_OK,
+	ADDR_NONE),
 EXCMD(CMD_dsearch,	"dsearch",	ex_findpat,
 	EX_BANG|EX_RANGE|EX_DFLALL|EX_WHOLEFOLD|EX_EXTRA|EX_CMDWIN|EX_LOCK_OK,
 	ADDR_LINES),
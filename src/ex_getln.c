@@ -417,6 +417,8 @@ may_do_incsearch_highlighting(
     pos_T	end_pos;
 #ifdef FEAT_RELTIME
     searchit_arg_T sia;
+    linenr_T	start_lnum;
+    linenr_T	resume_lnum;
 #endif
     int		next_char;
     int		use_last_pat;
@@ -491,6 +493,9 @@ may_do_incsearch_highlighting(
 	CLEAR_FIELD(sia);
 	// Set the time limit to half a second.
 	sia.sa_tm = 500;
+#endif
+#ifdef FEAT_RELTIME
+	start_lnum = curwin->w_cursor.lnum;
 #endif
 	found = do_search(NULL, firstc == ':' ? '/' : firstc, search_delim,
 				 ccline.cmdbuff + skiplen, patlen, count, search_flags,
@@ -500,6 +505,28 @@ may_do_incsearch_highlighting(
 		NULL
 #endif
 		);
+#ifdef FEAT_RELTIME
+	// When the time limit was reached and no key was typed, continue
+	// searching in slices of half a second, each one starting in the line
+	// where the previous one stopped.  Give up when a key is typed or when
+	// a slice did not get past its first line.
+	resume_lnum = 0;
+	while (found == 0 && count == 1 && sia.sa_timed_out && !got_int
+		&& sia.sa_timed_out_lnum != start_lnum
+		&& sia.sa_timed_out_lnum != resume_lnum && !char_avail())
+	{
+	    resume_lnum = sia.sa_timed_out_lnum;
+	    if (sia.sa_wrapped)
+		// don't search past where the first slice started
+		sia.sa_stop_lnum = start_lnum;
+	    sia.sa_timed_out = FALSE;
+	    curwin->w_cursor.lnum = resume_lnum;
+	    curwin->w_cursor.col = firstc == '?' ? MAXCOL : 0;
+	    found = do_search(NULL, firstc == ':' ? '/' : firstc,
+			     search_delim, ccline.cmdbuff + skiplen, patlen,
+				      count, search_flags | SEARCH_START, &sia);
+	}
+#endif
 	ccline.cmdbuff[skiplen + patlen] = next_char;
 	--emsg_off;
 
@@ -1737,7 +1764,9 @@ getcmdline_int(
 
 #ifdef FEAT_STL_OPT
     // Redraw the statusline in case it uses the current mode using the mode()
-    // function.
+    // function.  Only when it did use it the last time, evaluating the
+    // statusline of every window can be slow.  Also redraw the ones that
+    // already need it, e.g. because a CmdlineEnter autocommand changed them.
     if (!cmd_silent && msg_scrolled == 0)
     {
 	int	found_one = FALSE;
@@ -1746,14 +1775,18 @@ getcmdline_int(
 	FOR_ALL_WINDOWS(wp)
 	    if (*p_stl != NUL || *wp->w_p_stl != NUL)
 	    {
-		wp->w_redr_status = TRUE;
-		found_one = TRUE;
+		if (wp->w_stl_uses_mode)
+		    wp->w_redr_status = TRUE;
+		if (wp->w_redr_status)
+		    found_one = TRUE;
 	    }
 
 	if (*p_tal != NUL)
 	{
-	    redraw_tabline = TRUE;
-	    found_one = TRUE;
+	    if (tabline_uses_mode)
+		redraw_tabline = TRUE;
+	    if (redraw_tabline)
+		found_one = TRUE;
 	}
 
 	if (found_one)
@@ -4258,6 +4291,9 @@ f_getcmdscreenpos(typval_T *argvars UNUSED, typval_T *rettv)
     void
 f_getcmdtype(typval_T *argvars UNUSED, typval_T *rettv)
 {
+#ifdef FEAT_STL_OPT
+    stl_uses_mode = TRUE;
+#endif
     rettv->v_type = VAR_STRING;
     rettv->vval.v_string = alloc(2);
     if (rettv->vval.v_string == NULL)
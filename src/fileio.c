@@ -4139,6 +4139,25 @@ move_lines(buf_T *frombuf, buf_T *tobuf)
     return retval;
 }
 
+#ifdef FEAT_SYN_HL
+/*
+ * Return the first line in "buf" that is different from the same line in
+ * "oldbuf".  Returns one more than the line count when all lines are equal.
+ */
+    static linenr_T
+first_changed_line(buf_T *oldbuf, buf_T *buf)
+{
+    linenr_T	lnum;
+
+    for (lnum = 1; lnum <= buf->b_ml.ml_line_count
+				  && lnum <= oldbuf->b_ml.ml_line_count; ++lnum)
+	if (STRCMP(ml_get_buf(oldbuf, lnum, FALSE),
+					  ml_get_buf(buf, lnum, FALSE)) != 0)
+	    break;
+    return lnum;
+}
+#endif
+
 /*
  * Check if buffer "buf" has been changed.
  * Also check if the file for a new buffer unexpectedly appeared.
@@ -4471,6 +4490,10 @@ buf_reload(buf_T *buf, int orig_mode, int reload_options)
     aco_save_T	aco;
     int		flags = READ_NEW;
     int		prepped = OK;
+#ifdef FEAT_SYN_HL
+    synsave_T	synsave;
+    linenr_T	syn_lnum = 1;
+#endif
 
     // Set curwin/curbuf for "buf" and save some things.
     aucmd_prepbuf(&aco, buf);
@@ -4544,6 +4567,10 @@ buf_reload(buf_T *buf, int orig_mode, int reload_options)
 	    if (shortmess(SHM_FILEINFO))
 		msg_silent = 1;
 
+#ifdef FEAT_SYN_HL
+	    // Keep the syntax states for the lines that did not change.
+	    syn_stack_save(buf, &synsave);
+#endif
 	    if (readfile(buf->b_ffname, buf->b_fname, (linenr_T)0,
 			(linenr_T)0,
 			(linenr_T)MAXLNUM, &ea, flags) != OK)
@@ -4564,6 +4591,10 @@ buf_reload(buf_T *buf, int orig_mode, int reload_options)
 	    }
 	    else if (buf == curbuf)  // "buf" still valid
 	    {
+#ifdef FEAT_SYN_HL
+		if (savebuf != NULL && bufref_valid(&bufref))
+		    syn_lnum = first_changed_line(savebuf, buf);
+#endif
 		// Mark the buffer as unmodified and free undo info.
 		unchanged(buf, TRUE, TRUE);
 		if ((flags & READ_KEEP_UNDO) == 0)
@@ -4617,6 +4648,11 @@ buf_reload(buf_T *buf, int orig_mode, int reload_options)
 
 	// Modelines must override settings done by autocommands.
 	do_modelines(0);
+
+#ifdef FEAT_SYN_HL
+	if (saved == OK)
+	    syn_stack_restore(buf == curbuf ? buf : NULL, &synsave, syn_lnum);
+#endif
     }
 
     // restore curwin/curbuf and a few other things
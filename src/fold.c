@@ -53,6 +53,8 @@ static linenr_T setManualFold(linenr_T lnum, int opening, int recurse, int *done
 static linenr_T setManualFoldWin(win_T *wp, linenr_T lnum, int opening, int recurse, int *donep);
 static void foldOpenNested(fold_T *fpr);
 static void deleteFoldEntry(garray_T *gap, int idx, int recursive);
+static void foldPasteFlushWin(win_T *wp);
+static void foldMarkAdjustWin(win_T *wp, linenr_T line1, linenr_T line2, long amount, long amount_after);
 static void foldMarkAdjustRecurse(garray_T *gap, linenr_T line1, linenr_T line2, long amount, long amount_after);
 static int getDeepestNestingRecurse(garray_T *gap);
 static int check_closed(win_T *win, fold_T *fp, int *use_levelp, int level, int *maybe_smallp, linenr_T lnum_off);
@@ -82,6 +84,12 @@ static linenr_T invalid_bot = (linenr_T)0;
 static linenr_T prev_lnum = 0;
 static int prev_lnum_lvl = -1;
 
+/*
+ * Number of lines that foldMarkAdjust() handles as appended in Insert mode.
+ * More than one when adjusting for lines pasted in Insert mode.
+ */
+static long fold_ins_lines = 1;
+
 // Flags used for "done" argument of setManualFold.
 #define DONE_NOTHING	0
 #define DONE_ACTION	1	// did close or open a fold
@@ -446,6 +454,14 @@ foldOpenCursor(void)
 {
     int		done;
 
+    // While pasting in Insert mode the cursor is in the pasted lines, their
+    // folds are opened when the paste ends.
+    if (fold_paste_busy > 0 && curwin->w_fold_paste_count > 0
+	    && curwin->w_cursor.lnum >= curwin->w_fold_paste_lnum - 1
+	    && curwin->w_cursor.lnum < curwin->w_fold_paste_lnum
+					       + curwin->w_fold_paste_count)
+	return;
+
     checkupdate(curwin);
     if (hasAnyFolding(curwin))
 	for (;;)
@@ -857,11 +873,21 @@ foldUpdate(win_T *wp, linenr_T top, linenr_T bot)
 	    || foldmethodIsSyntax(wp))
     {
 	int save_got_int = got_int;
+#ifdef FEAT_PROFILE
+	proftime_T  dt_tm;
+
+	if (drawtime_active)
+	    profile_start(&dt_tm);
+#endif
 
 	// reset got_int here, otherwise it won't work
 	got_int = FALSE;
 	foldUpdateIEMS(wp, top, bot);
 	got_int |= save_got_int;
+#ifdef FEAT_PROFILE
+	if (drawtime_active)
+	    drawtime_add(DRAWTIME_FOLDS, &dt_tm);
+#endif
     }
 }
 
@@ -879,6 +905,66 @@ foldUpdateAll(win_T *win)
     redraw_win_later(win, UPD_NOT_VALID);
 }
 
+// foldexpr_cache_clear() {{{2
+/*
+ * Clear the cached 'foldexpr' results of window "wp".
+ */
+    void
+foldexpr_cache_clear(win_T *wp)
+{
+    fdecache_T	*fc = &wp->w_fdecache;
+
+    ga_clear(&fc->fc_ga);
+    VIM_CLEAR(fc->fc_expr);
+    fc->fc_buf = NULL;
+}
+
+// foldPasteUpdate() {{{2
+/*
+ * Used instead of foldUpdate() for lines "top" to "bot" changed while pasting
+ * in Insert mode: remember the lines, the folds are updated for all of them
+ * at once by foldPasteFlush().
+ */
+    void
+foldPasteUpdate(win_T *wp, linenr_T top, linenr_T bot)
+{
+    if (top > bot)
+    {
+	linenr_T    tmp = top;
+
+	top = bot;
+	bot = tmp;
+    }
+    if (wp->w_fold_paste_top == 0)
+    {
+	wp->w_fold_paste_top = top;
+	wp->w_fold_paste_bot = bot;
+    }
+    else
+    {
+	if (top < wp->w_fold_paste_top)
+	    wp->w_fold_paste_top = top;
+	if (bot > wp->w_fold_paste_bot)
+	    wp->w_fold_paste_bot = bot;
+    }
+}
+
+// foldPasteFlush() {{{2
+/*
+ * Adjust and update the folds in all windows for what was pasted in Insert
+ * mode so far.  Called when the paste ends and before waiting for more text,
+ * since that may invoke callbacks that use the folds.
+ */
+    void
+foldPasteFlush(void)
+{
+    tabpage_T	*tp;
+    win_T	*wp;
+
+    FOR_ALL_TAB_WINDOWS(tp, wp)
+	foldPasteFlushWin(wp);
+}
+
 // foldMoveTo() {{{2
 /*
  * If "updown" is FALSE: Move to the start or end of the fold.
@@ -1215,6 +1301,8 @@ foldLevelWin(win_T *wp, linenr_T lnum)
     static void
 checkupdate(win_T *wp)
 {
+    if (wp->w_fold_paste_count > 0 || wp->w_fold_paste_top > 0)
+	foldPasteFlushWin(wp);
     if (!wp->w_foldinvalid)
 	return;
 
@@ -1489,6 +1577,52 @@ deleteFoldRecurse(garray_T *gap)
     ga_clear(gap);
 }
 
+// foldPasteFlushWin() {{{2
+/*
+ * Adjust and update the folds in window "wp" for lines pasted in Insert mode.
+ */
+    static void
+foldPasteFlushWin(win_T *wp)
+{
+    linenr_T	lnum = wp->w_fold_paste_lnum;
+    long	count = wp->w_fold_paste_count;
+    linenr_T	top = wp->w_fold_paste_top;
+    int		done;
+
+    wp->w_fold_paste_count = 0;
+    wp->w_fold_paste_top = 0;
+    if (count > 0)
+    {
+	// Lines appended one after the other in Insert mode end up in the
+	// same folds as when they are inserted at once.
+	fold_ins_lines = count;
+	foldMarkAdjustWin(wp, lnum, (linenr_T)MAXLNUM, count, 0L);
+	fold_ins_lines = 1;
+    }
+    if (top > 0)
+	foldUpdate(wp, top, wp->w_fold_paste_bot);
+
+    if (wp == curwin && count > 0 && hasAnyFolding(wp))
+    {
+	// Open the folds that the cursor was in while pasting, like
+	// foldOpenCursor() does for each line.
+	for (--lnum; lnum < wp->w_fold_paste_lnum + count - 1; ++lnum)
+	    do
+	    {
+		done = DONE_NOTHING;
+		(void)setManualFold(lnum, TRUE, FALSE, &done);
+	    } while (done & DONE_ACTION);
+    }
+
+    if (count > 0 || top > 0)
+    {
+	// The lines below the change may be displayed differently now.
+	redraw_win_later(wp, UPD_NOT_VALID);
+	if (hasAnyFolding(wp))
+	    set_topline(wp, wp->w_topline);
+    }
+}
+
 // foldMarkAdjust() {{{2
 /*
  * Update line numbers of folds for inserted/deleted lines.
@@ -1500,6 +1634,41 @@ foldMarkAdjust(
     linenr_T	line2,
     long	amount,
     long	amount_after)
+{
+    if (fold_paste_busy > 0)
+    {
+	// While pasting in Insert mode, postpone adjusting the folds for lines
+	// appended below the previously appended one, so that the folds below
+	// them are moved only once.
+	if ((State & MODE_INSERT) && amount == 1L && line2 == MAXLNUM
+		&& amount_after == 0L
+		&& (wp->w_fold_paste_count == 0
+		    || line1 == wp->w_fold_paste_lnum
+						   + wp->w_fold_paste_count))
+	{
+	    if (wp->w_fold_paste_count == 0)
+		wp->w_fold_paste_lnum = line1;
+	    ++wp->w_fold_paste_count;
+	    if (wp->w_fold_paste_top >= line1)
+		++wp->w_fold_paste_top;
+	    if (wp->w_fold_paste_top > 0 && wp->w_fold_paste_bot >= line1
+					    && wp->w_fold_paste_bot < MAXLNUM)
+		++wp->w_fold_paste_bot;
+	    return;
+	}
+	foldPasteFlushWin(wp);
+    }
+    foldMarkAdjustWin(wp, line1, line2, amount, amount_after);
+}
+
+// foldMarkAdjustWin() {{{2
+    static void
+foldMarkAdjustWin(
+    win_T	*wp,
+    linenr_T	line1,
+    linenr_T	line2,
+    long	amount,
+    long	amount_after)
 {
     // If deleting marks from line1 to line2, but not deleting all those
     // lines, set line2 so that only deleted lines have their folds removed.
@@ -1507,7 +1676,8 @@ foldMarkAdjust(
 	line2 = line1 - amount_after - 1;
     // If appending a line in Insert mode, it should be included in the fold
     // just above the line.
-    if ((State & MODE_INSERT) && amount == (linenr_T)1 && line2 == MAXLNUM)
+    if ((State & MODE_INSERT) && amount == fold_ins_lines
+							  && line2 == MAXLNUM)
 	--line1;
     foldMarkAdjustRecurse(&wp->w_folds, line1, line2, amount, amount_after);
 }
@@ -1531,7 +1701,7 @@ foldMarkAdjustRecurse(
 
     // In Insert mode an inserted line at the top of a fold is considered part
     // of the fold, otherwise it isn't.
-    if ((State & MODE_INSERT) && amount == (linenr_T)1 && line2 == MAXLNUM)
+    if ((State & MODE_INSERT) && amount == fold_ins_lines && line2 == MAXLNUM)
 	top = line1 + 1;
     else
 	top = line1;
@@ -2174,6 +2344,9 @@ foldUpdateIEMS(win_T *wp, linenr_T top, linenr_T bot)
 	bot = wp->w_buffer->b_ml.ml_line_count;
 	wp->w_foldinvalid = FALSE;
 
+	// Evaluate 'foldexpr' again for all lines.
+	foldexpr_cache_clear(wp);
+
 	// Mark all folds as maybe-small.
 	setSmallMaybe(&wp->w_folds);
     }
@@ -3295,10 +3468,77 @@ foldlevelDiff(fline_T *flp)
 }
 #endif
 
+#ifdef FEAT_EVAL
+// foldexpr_cached() {{{2
+/*
+ * Get the result of 'foldexpr' for line "lnum" in window "wp", which must be
+ * the current window.  Sets "*cp" to the character before the number.
+ * Uses the cached result when there is one, otherwise evaluates the
+ * expression and adds the result to the cache.  The cache is cleared when
+ * the text changes, a result may depend on any line.
+ */
+    static int
+foldexpr_cached(win_T *wp, linenr_T lnum, int *cp)
+{
+    fdecache_T	*fc = &wp->w_fdecache;
+    buf_T	*buf = wp->w_buffer;
+    fdeentry_T	*fe;
+    int		n;
+    int		save_keytyped;
+
+    if (fc->fc_buf != buf
+	    || fc->fc_changedtick != CHANGEDTICK(buf)
+	    || STRCMP(fc->fc_expr, wp->w_p_fde) != 0)
+    {
+	foldexpr_cache_clear(wp);
+	fc->fc_expr = vim_strsave(wp->w_p_fde);
+	if (fc->fc_expr != NULL)
+	{
+	    ga_init2(&fc->fc_ga, sizeof(fdeentry_T), 100);
+	    fc->fc_buf = buf;
+	    fc->fc_changedtick = CHANGEDTICK(buf);
+	}
+    }
+
+    if (lnum <= fc->fc_ga.ga_len)
+    {
+	fe = (fdeentry_T *)fc->fc_ga.ga_data + lnum - 1;
+	if (fe->fe_valid)
+	{
+	    *cp = fe->fe_type;
+	    return fe->fe_level;
+	}
+    }
+
+    // KeyTyped may be reset to 0 when calling a function which invokes
+    // do_cmdline().  To make 'foldopen' work correctly restore KeyTyped.
+    save_keytyped = KeyTyped;
+    n = eval_foldexpr(wp, cp);
+    KeyTyped = save_keytyped;
+
+    // The expression may have changed something that cleared the cache.
+    if (fc->fc_buf == buf && lnum <= buf->b_ml.ml_line_count)
+    {
+	if (lnum > fc->fc_ga.ga_len)
+	{
+	    if (ga_grow(&fc->fc_ga, lnum - fc->fc_ga.ga_len) == FAIL)
+		return n;
+	    // ga_grow() clears the new items.
+	    fc->fc_ga.ga_len = lnum;
+	}
+	fe = (fdeentry_T *)fc->fc_ga.ga_data + lnum - 1;
+	fe->fe_level = n;
+	fe->fe_type = *cp;
+	fe->fe_valid = TRUE;
+    }
+    return n;
+}
+#endif
+
 // foldlevelExpr() {{{2
 /*
  * Low level function to get the foldlevel for the "expr" method.
- * Doesn't use any caching.
+ * Uses the cached result of 'foldexpr' when there is one.
  * Returns a level of -1 if the foldlevel depends on surrounding lines.
  */
     static void
@@ -3312,7 +3552,6 @@ foldlevelExpr(fline_T *flp)
     int		n;
     int		c;
     linenr_T	lnum = flp->lnum + flp->off;
-    int		save_keytyped;
 
     win = curwin;
     curwin = flp->wp;
@@ -3325,11 +3564,7 @@ foldlevelExpr(fline_T *flp)
     if (lnum <= 1)
 	flp->lvl = 0;
 
-    // KeyTyped may be reset to 0 when calling a function which invokes
-    // do_cmdline().  To make 'foldopen' work correctly restore KeyTyped.
-    save_keytyped = KeyTyped;
-    n = eval_foldexpr(flp->wp, &c);
-    KeyTyped = save_keytyped;
+    n = foldexpr_cached(flp->wp, lnum, &c);
 
     switch (c)
     {
@@ -3730,7 +3965,9 @@ f_foldlevel(typval_T *argvars UNUSED, typval_T *rettv UNUSED)
 
     lnum = tv_get_lnum(argvars);
     if (lnum >= 1 && lnum <= curbuf->b_ml.ml_line_count)
+    {
 	rettv->vval.v_number = foldLevel(lnum);
+    }
 # endif
 }
 
@@ -3903,7 +3903,14 @@ inchar(
     if (wait_time == -1L || wait_time > 100L)  // flush output before waiting
     {
 	cursor_on();
-	out_flush_cursor(FALSE, FALSE);
+#ifdef FEAT_GUI
+	if (gui.in_use)
+	    out_flush_cursor(FALSE, FALSE);
+	else
+#endif
+	    // Don't wait for a slow terminal, typed characters can be handled
+	    // meanwhile.
+	    out_flush_nowait();
 #if defined(FEAT_GUI) && defined(FEAT_MOUSESHAPE)
 	if (gui.in_use && postponed_mouseshape)
 	    update_mouseshape(-1);
@@ -3986,10 +3993,11 @@ inchar(
 
 	/*
 	 * Always flush the output characters when getting input characters
-	 * from the user and not just peeking.
+	 * from the user and not just peeking.  Don't wait for a slow terminal,
+	 * typed characters can be handled meanwhile.
 	 */
 	if (wait_time == -1L || wait_time > 10L)
-	    out_flush();
+	    out_flush_nowait();
 
 	/*
 	 * Fill up to a third of the buffer, because each character may be
@@ -734,6 +734,9 @@ EXTERN char_u	hash_removed;
 
 
 EXTERN int	scroll_region INIT(= FALSE); // term supports scroll region
+#ifdef UNIX
+EXTERN int	write_nowait INIT(= FALSE); // see out_flush_nowait()
+#endif
 EXTERN int	t_colors INIT(= 0);	    // int value of T_CCO
 
 // Flags to indicate an additional string for highlight name completion.
@@ -1513,6 +1516,15 @@ EXTERN int	maptick INIT(= 0);	// tick for each non-mapped char
 EXTERN int	must_redraw INIT(= 0);	    // type of redraw necessary
 EXTERN int	skip_redraw INIT(= FALSE);  // skip redraw once
 EXTERN int	do_redraw INIT(= FALSE);    // extra redraw once
+// Incremented when a setting changed that may change the number of screen
+// lines used by a buffer line, see changed_window_setting_win().
+EXTERN int	display_setting_tick INIT(= 0);
+#ifdef FEAT_PROFILE
+// TRUE while the current screen update is measured with ":drawtime".
+EXTERN int	drawtime_active INIT(= FALSE);
+// TRUE until the output of a measured screen update was written.
+EXTERN int	drawtime_output INIT(= FALSE);
+#endif
 #ifdef FEAT_DIFF
 EXTERN int	need_diff_redraw INIT(= 0); // need to call diff_redraw()
 #endif
@@ -1671,6 +1683,7 @@ EXTERN char_u	*globaldir INIT(= NULL);
 
 #ifdef FEAT_FOLDING
 EXTERN int	disable_fold_update INIT(= 0);
+EXTERN int	fold_paste_busy INIT(= 0);  // pasting in Insert mode
 #endif
 
 // Whether 'keymodel' contains "stopsel" and "startsel".
@@ -1718,6 +1731,11 @@ EXTERN char_u	wim_flags[4];
 # define STL_IN_ICON	1
 # define STL_IN_TITLE	2
 EXTERN int      stl_syntax INIT(= 0);
+
+// Set when mode() or getcmdtype() is called, to find out if a status line or
+// the tab pages line shows the current mode.
+EXTERN int	stl_uses_mode INIT(= FALSE);
+EXTERN int	tabline_uses_mode INIT(= FALSE);
 #endif
 
 #if defined(FEAT_BEVAL) && !defined(NO_X11_INCLUDES)
@@ -17,6 +17,24 @@
 
 # define SEARCH_HL_PRIORITY 0
 
+/*
+ * Function passed to qsort() to sort matchaddpos() positions on line and
+ * column.
+ */
+    static int
+match_pos_compare(const void *s1, const void *s2)
+{
+    llpos_T *p1 = *(llpos_T **)s1;
+    llpos_T *p2 = *(llpos_T **)s2;
+
+    if (p1->lnum != p2->lnum)
+	return p1->lnum < p2->lnum ? -1 : 1;
+    if (p1->col != p2->col)
+	return p1->col < p2->col ? -1 : 1;
+    // keep the order in which they were given
+    return p1 < p2 ? -1 : p1 > p2 ? 1 : 0;
+}
+
 /*
  * Add match to the match list of window "wp".
  * If "pat" is not NULL the pattern will be highlighted with the group "grp"
@@ -104,6 +122,7 @@ match_add(
     m->mit_match.regprog = regprog;
     m->mit_match.rmm_ic = FALSE;
     m->mit_match.rmm_maxcol = 0;
+    m->mit_linelocal = pat != NULL && re_linelocal(pat, regprog);
 # if defined(FEAT_CONCEAL)
     m->mit_conceal_char = 0;
     if (conceal_char != NULL)
@@ -169,7 +188,8 @@ match_add(
 		    --i;
 		    continue;
 		}
-		m->mit_pos_array[i].lnum = li->li_tv.vval.v_number;
+		lnum = li->li_tv.vval.v_number;
+		m->mit_pos_array[i].lnum = lnum;
 		m->mit_pos_array[i].col = 0;
 		m->mit_pos_array[i].len = 0;
 	    }
@@ -183,10 +203,21 @@ match_add(
 	    if (botlnum == 0 || lnum >= botlnum)
 		botlnum = lnum + 1;
 	}
+	m->mit_pos_count = i;
 
 	// Calculate top and bottom lines for redrawing area
 	if (toplnum != 0)
 	{
+	    // Sort the positions, so that the ones in a line can be found
+	    // quickly when drawing.
+	    m->mit_pos_sorted = ALLOC_MULT(llpos_T *, i);
+	    if (m->mit_pos_sorted == NULL)
+		goto fail;
+	    while (--i >= 0)
+		m->mit_pos_sorted[i] = &m->mit_pos_array[i];
+	    qsort((void *)m->mit_pos_sorted, (size_t)m->mit_pos_count,
+					   sizeof(llpos_T *), match_pos_compare);
+
 	    if (wp->w_buffer->b_mod_set)
 	    {
 		if (wp->w_buffer->b_mod_top > toplnum)
@@ -228,6 +259,7 @@ match_add(
 fail:
     vim_free(m->mit_pattern);
     vim_free(m->mit_pos_array);
+    vim_free(m->mit_pos_sorted);
     vim_free(m);
     return -1;
 }
@@ -267,6 +299,7 @@ match_delete(win_T *wp, int id, int perr)
 	prev->mit_next = cur->mit_next;
     vim_regfree(cur->mit_match.regprog);
     vim_free(cur->mit_pattern);
+    match_cache_clear(wp);
     if (cur->mit_toplnum != 0)
     {
 	if (wp->w_buffer->b_mod_set)
@@ -286,7 +319,9 @@ match_delete(win_T *wp, int id, int perr)
 	rtype = UPD_VALID;
     }
     vim_free(cur->mit_pos_array);
+    vim_free(cur->mit_pos_sorted);
     vim_free(cur);
+    wp->w_match_line_head = NULL;
     redraw_win_later(wp, rtype);
     return 0;
 }
@@ -305,12 +340,259 @@ clear_matches(win_T *wp)
 	vim_regfree(wp->w_match_head->mit_match.regprog);
 	vim_free(wp->w_match_head->mit_pattern);
 	vim_free(wp->w_match_head->mit_pos_array);
+	vim_free(wp->w_match_head->mit_pos_sorted);
 	vim_free(wp->w_match_head);
 	wp->w_match_head = m;
     }
+    wp->w_match_line_head = NULL;
+    match_cache_clear(wp);
     redraw_win_later(wp, UPD_SOME_VALID);
 }
 
+/*
+ * Clear the cached 'hlsearch' and match results of window "wp".
+ */
+    void
+match_cache_clear(win_T *wp)
+{
+    matchcache_T *mc = &wp->w_match_cache;
+
+    VIM_CLEAR(mc->mc_hlpat);
+    VIM_CLEAR(mc->mc_isk);
+    ga_clear(&mc->mc_ga);
+    mc->mc_buf = NULL;
+}
+
+/*
+ * Clear the cache of window "wp" and start caching results for buffer "buf"
+ * as it is now.
+ */
+    static void
+match_cache_start(win_T *wp, buf_T *buf)
+{
+    matchcache_T *mc = &wp->w_match_cache;
+
+    match_cache_clear(wp);
+    mc->mc_isk = vim_strsave(buf->b_p_isk);
+    if (mc->mc_isk == NULL)
+	return;
+    mc->mc_buf = buf;
+    mc->mc_changedtick = CHANGEDTICK(buf);
+    mc->mc_re = p_re;
+}
+
+/*
+ * Return the index of the first cached result in "mc" for line "lnum" or a
+ * later line.
+ */
+    static int
+match_cache_find_line(matchcache_T *mc, linenr_T lnum)
+{
+    mcentry_T	*me = (mcentry_T *)mc->mc_ga.ga_data;
+    int		lo = 0;
+    int		hi = mc->mc_ga.ga_len;
+    int		mid;
+
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	if (me[mid].me_lnum < lnum)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Called by changed_common() for a change in the buffer of window "wp" from
+ * line "lnum" until "lnume" (not including), with "xtra" lines added.
+ * "old_tick" is b:changedtick from before the change.
+ * Drops the cached results for the changed lines and adjusts the line number
+ * of the ones below them.
+ */
+    void
+match_cache_changed(
+    win_T	*wp,
+    linenr_T	lnum,
+    linenr_T	lnume,
+    long	xtra,
+    varnumber_T	old_tick)
+{
+    matchcache_T    *mc = &wp->w_match_cache;
+    mcentry_T	    *me;
+    int		    first;
+    int		    last;
+    int		    i;
+
+    if (mc->mc_buf == NULL)
+	return;
+    if (mc->mc_buf != wp->w_buffer || mc->mc_changedtick != old_tick
+		       || CHANGEDTICK(wp->w_buffer) != old_tick + 1)
+    {
+	match_cache_clear(wp);
+	return;
+    }
+
+    me = (mcentry_T *)mc->mc_ga.ga_data;
+    first = match_cache_find_line(mc, lnum);
+    last = match_cache_find_line(mc, lnume);
+    if (last > first)
+    {
+	mch_memmove(me + first, me + last,
+			      sizeof(mcentry_T) * (mc->mc_ga.ga_len - last));
+	mc->mc_ga.ga_len -= last - first;
+    }
+    if (xtra != 0)
+	for (i = first; i < mc->mc_ga.ga_len; ++i)
+	    me[i].me_lnum += xtra;
+    mc->mc_changedtick = CHANGEDTICK(wp->w_buffer);
+}
+
+/*
+ * Check whether results for "shl" can be cached in window "wp".  Clears the
+ * cache when it is for another buffer, text or 'hlsearch' pattern.
+ * Returns the match ID to use in the cache, -1 when not to be cached.
+ */
+    static int
+match_cache_id(
+    win_T	*wp,
+    match_T	*search_hl,
+    match_T	*shl,
+    matchitem_T	*cur)
+{
+    matchcache_T    *mc = &wp->w_match_cache;
+    char_u	    *pat;
+
+    // Results depend on 'regexpengine' and 'iskeyword'.  For 'isident',
+    // 'isfname' and 'isprint' buf_init_chartab() clears the cache.
+    if (mc->mc_buf != NULL && (mc->mc_re != p_re
+			      || STRCMP(mc->mc_isk, mc->mc_buf->b_p_isk) != 0))
+	match_cache_clear(wp);
+
+    if (shl != search_hl)
+	return cur != NULL && shl == &cur->mit_hl && cur->mit_linelocal
+							  ? cur->mit_id : -1;
+
+    if (mc->mc_buf != shl->buf
+	    || mc->mc_changedtick != CHANGEDTICK(shl->buf))
+	match_cache_start(wp, shl->buf);
+
+    pat = last_search_pat();
+    if (pat == NULL)
+	return -1;
+    if (mc->mc_hlpat == NULL || STRCMP(mc->mc_hlpat, pat) != 0
+	    || mc->mc_hlmagic != last_search_pat_magic()
+	    || mc->mc_hlic != shl->rm.rmm_ic)
+    {
+	int	    idx;
+	int	    i;
+	mcentry_T   *me = (mcentry_T *)mc->mc_ga.ga_data;
+
+	// Drop the results for the old 'hlsearch' pattern.
+	for (i = 0, idx = 0; i < mc->mc_ga.ga_len; ++i)
+	    if (me[i].me_id != 0)
+		me[idx++] = me[i];
+	mc->mc_ga.ga_len = idx;
+
+	vim_free(mc->mc_hlpat);
+	mc->mc_hlpat = vim_strsave(pat);
+	if (mc->mc_hlpat == NULL)
+	    return -1;
+	mc->mc_hlmagic = last_search_pat_magic();
+	mc->mc_hlic = shl->rm.rmm_ic;
+	mc->mc_hllinelocal = re_linelocal(pat, shl->rm.regprog);
+    }
+    return mc->mc_hllinelocal ? 0 : -1;
+}
+
+/*
+ * Look up the result of searching for match "id" in line "lnum" from column
+ * "col" in the cache of window "wp".  When found, set "shl->rm" and
+ * "nmatched" and return TRUE.
+ */
+    static int
+match_cache_lookup(
+    win_T	*wp,
+    int		id,
+    linenr_T	lnum,
+    colnr_T	col,
+    match_T	*shl,
+    long	*nmatched)
+{
+    matchcache_T    *mc = &wp->w_match_cache;
+    mcentry_T	    *me = (mcentry_T *)mc->mc_ga.ga_data;
+    int		    i;
+
+    if (mc->mc_buf != shl->buf || mc->mc_changedtick != CHANGEDTICK(shl->buf))
+	return FALSE;
+    for (i = match_cache_find_line(mc, lnum);
+			i < mc->mc_ga.ga_len && me[i].me_lnum == lnum; ++i)
+	if (me[i].me_id == id && me[i].me_col == col)
+	{
+	    *nmatched = me[i].me_nmatched;
+	    shl->rm.startpos[0] = me[i].me_startpos;
+	    shl->rm.endpos[0] = me[i].me_endpos;
+	    return TRUE;
+	}
+    return FALSE;
+}
+
+/*
+ * Add the result of searching for match "id" in line "lnum" from column "col"
+ * to the cache of window "wp".
+ */
+    static void
+match_cache_add(
+    win_T	*wp,
+    int		id,
+    linenr_T	lnum,
+    colnr_T	col,
+    match_T	*shl,
+    long	nmatched)
+{
+    matchcache_T    *mc = &wp->w_match_cache;
+    mcentry_T	    *me;
+    int		    i;
+
+    if (mc->mc_buf != shl->buf || mc->mc_changedtick != CHANGEDTICK(shl->buf))
+    {
+	match_cache_start(wp, shl->buf);
+	if (mc->mc_buf == NULL)
+	    return;
+    }
+    if (mc->mc_ga.ga_itemsize == 0)
+	ga_init2(&mc->mc_ga, sizeof(mcentry_T), 100);
+
+    // Only keep results for lines near the window, drop the others when
+    // there are many.
+    if (mc->mc_ga.ga_len >= 1000 + 100 * wp->w_height)
+    {
+	int	first = match_cache_find_line(mc, wp->w_topline - wp->w_height);
+	int	last = match_cache_find_line(mc, wp->w_botline + wp->w_height);
+
+	me = (mcentry_T *)mc->mc_ga.ga_data;
+	mch_memmove(me, me + first, sizeof(mcentry_T) * (last - first));
+	mc->mc_ga.ga_len = last - first;
+    }
+    if (ga_grow(&mc->mc_ga, 1) == FAIL)
+	return;
+
+    me = (mcentry_T *)mc->mc_ga.ga_data;
+    for (i = match_cache_find_line(mc, lnum); i < mc->mc_ga.ga_len
+		&& me[i].me_lnum == lnum && (me[i].me_id < id
+			|| (me[i].me_id == id && me[i].me_col < col)); ++i)
+	;
+    mch_memmove(me + i + 1, me + i, sizeof(mcentry_T) * (mc->mc_ga.ga_len - i));
+    me[i].me_lnum = lnum;
+    me[i].me_id = id;
+    me[i].me_col = col;
+    me[i].me_nmatched = nmatched;
+    me[i].me_startpos = shl->rm.startpos[0];
+    me[i].me_endpos = shl->rm.endpos[0];
+    ++mc->mc_ga.ga_len;
+}
+
 /*
  * Get match from ID 'id' in window 'wp'.
  * Return NULL if match not found.
@@ -348,12 +630,35 @@ init_search_hl(win_T *wp, match_T *search_hl)
 	cur->mit_hl.first_lnum = 0;
 	cur = cur->mit_next;
     }
+    wp->w_match_line_head = NULL;
     search_hl->buf = wp->w_buffer;
     search_hl->lnum = 0;
     search_hl->first_lnum = 0;
     // time limit is set at the toplevel, for all windows
 }
 
+/*
+ * Return the index in the sorted positions of "match" of the first position
+ * in line "lnum" or after it.
+ */
+    static int
+match_pos_find_line(matchitem_T *match, linenr_T lnum)
+{
+    int	    lo = 0;
+    int	    hi = match->mit_pos_count;
+
+    while (lo < hi)
+    {
+	int mid = (lo + hi) / 2;
+
+	if (match->mit_pos_sorted[mid]->lnum < lnum)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
 /*
  * If there is a match fill "shl" and return one.
  * Return zero otherwise.
@@ -366,41 +671,30 @@ next_search_hl_pos(
     colnr_T	    mincol)	// minimal column for a match
 {
     int	    i;
-    int	    found = -1;
 
-    for (i = match->mit_pos_cur; i < match->mit_pos_count; i++)
+    if (match->mit_pos_sorted == NULL)
+	return 0;
+
+    // Continue after the previously found position if it was in this line,
+    // otherwise start at the first position in this line.
+    i = match->mit_pos_cur;
+    if (i == 0 || match->mit_pos_sorted[i - 1]->lnum != lnum)
+	i = match_pos_find_line(match, lnum);
+    match->mit_pos_cur = 0;
+
+    for ( ; i < match->mit_pos_count; ++i)
     {
-	llpos_T	*pos = &match->mit_pos_array[i];
+	llpos_T	*pos = match->mit_pos_sorted[i];
+	colnr_T	start;
+	colnr_T	end;
 
-	if (pos->lnum == 0)
+	if (pos->lnum != lnum)
 	    break;
 	if (pos->len == 0 && pos->col < mincol)
 	    continue;
-	if (pos->lnum == lnum)
-	{
-	    if (found >= 0)
-	    {
-		// if this match comes before the one at "found" then swap them
-		if (pos->col < match->mit_pos_array[found].col)
-		{
-		    llpos_T	tmp = *pos;
-
-		    *pos = match->mit_pos_array[found];
-		    match->mit_pos_array[found] = tmp;
-		}
-	    }
-	    else
-		found = i;
-	}
-    }
-    match->mit_pos_cur = 0;
-    if (found >= 0)
-    {
-	colnr_T	start = match->mit_pos_array[found].col == 0
-				     ? 0 : match->mit_pos_array[found].col - 1;
-	colnr_T	end = match->mit_pos_array[found].col == 0
-			    ? MAXCOL : start + match->mit_pos_array[found].len;
 
+	start = pos->col == 0 ? 0 : pos->col - 1;
+	end = pos->col == 0 ? MAXCOL : start + pos->len;
 	shl->lnum = lnum;
 	shl->rm.startpos[0].lnum = 0;
 	shl->rm.startpos[0].col = start;
@@ -408,7 +702,7 @@ next_search_hl_pos(
 	shl->rm.endpos[0].col = end;
 	shl->is_addpos = TRUE;
 	shl->has_cursor = FALSE;
-	match->mit_pos_cur = found + 1;
+	match->mit_pos_cur = i + 1;
 	return 1;
     }
     return 0;
@@ -436,6 +730,7 @@ next_search_hl(
     long	nmatched;
     int		called_emsg_before = called_emsg;
     int		timed_out = FALSE;
+    int		cache_id = -1;
 
     // for :{range}s/pat only highlight inside the range
     if ((lnum < search_first_line || lnum > search_last_line) && cur == NULL)
@@ -457,6 +752,9 @@ next_search_hl(
 	    return;
     }
 
+    if (shl->rm.regprog != NULL)
+	cache_id = match_cache_id(win, search_hl, shl, cur);
+
     // Repeat searching for a match until one is found that includes "mincol"
     // or none is found in this line.
     for (;;)
@@ -491,7 +789,12 @@ next_search_hl(
 	    matchcol = shl->rm.endpos[0].col;
 
 	shl->lnum = lnum;
-	if (shl->rm.regprog != NULL)
+	if (shl->rm.regprog != NULL
+		&& cache_id >= 0
+		&& match_cache_lookup(win, cache_id, lnum, matchcol, shl,
+								   &nmatched))
+	    ;
+	else if (shl->rm.regprog != NULL)
 	{
 	    // Remember whether shl->rm is using a copy of the regprog in
 	    // cur->mit_match.
@@ -519,6 +822,8 @@ next_search_hl(
 		got_int = FALSE;  // avoid the "Type :quit to exit Vim" message
 		break;
 	    }
+	    if (cache_id >= 0)
+		match_cache_add(win, cache_id, lnum, matchcol, shl, nmatched);
 	}
 	else if (cur != NULL)
 	    nmatched = next_search_hl_pos(shl, lnum, cur, matchcol);
@@ -653,10 +958,13 @@ prepare_search_hl_line(
     int		shl_flag;		// flag to indicate whether search_hl
 					// has been processed or not
     int		area_highlighting = FALSE;
+    matchitem_T **line_tail = &wp->w_match_line_head;
 
     // Handle highlighting the last used search pattern and matches.
     // Do this for both search_hl and the match list.
     // Do not use search_hl in a popup window.
+    // The matches that may highlight something in this line are linked with
+    // mit_line_next, the other ones are skipped for each column.
     cur = wp->w_match_head;
     shl_flag = WIN_IS_POPUP(wp);
     while (cur != NULL || shl_flag == FALSE)
@@ -674,7 +982,17 @@ prepare_search_hl_line(
 	shl->is_addpos = FALSE;
 	shl->has_cursor = FALSE;
 	if (cur != NULL)
+	{
 	    cur->mit_pos_cur = 0;
+	    if (shl != search_hl && shl->rm.regprog == NULL
+		    && (lnum < cur->mit_toplnum || lnum >= cur->mit_botlnum))
+	    {
+		// no position in this line
+		shl->lnum = 0;
+		cur = cur->mit_next;
+		continue;
+	    }
+	}
 	next_search_hl(wp, search_hl, shl, lnum, mincol,
 						shl == search_hl ? NULL : cur);
 
@@ -714,8 +1032,16 @@ prepare_search_hl_line(
 	    area_highlighting = TRUE;
 	}
 	if (shl != search_hl && cur != NULL)
+	{
+	    if (shl->rm.regprog != NULL || shl->lnum != 0)
+	    {
+		*line_tail = cur;
+		line_tail = &cur->mit_line_next;
+	    }
 	    cur = cur->mit_next;
+	}
     }
+    *line_tail = NULL;
     return area_highlighting;
 }
 
@@ -751,8 +1077,9 @@ update_search_hl(
     int		search_attr = 0;
 
 
-    // Do this for 'search_hl' and the match list (ordered by priority).
-    cur = wp->w_match_head;
+    // Do this for 'search_hl' and the matches used in this line (ordered by
+    // priority).
+    cur = wp->w_match_line_head;
     shl_flag = WIN_IS_POPUP(wp);
     while (cur != NULL || shl_flag == FALSE)
     {
@@ -851,12 +1178,12 @@ update_search_hl(
 	    break;
 	}
 	if (shl != search_hl && cur != NULL)
-	    cur = cur->mit_next;
+	    cur = cur->mit_line_next;
     }
 
     // Use attributes from match with highest priority among 'search_hl' and
     // the match list.
-    cur = wp->w_match_head;
+    cur = wp->w_match_line_head;
     shl_flag = WIN_IS_POPUP(wp);
     while (cur != NULL || shl_flag == FALSE)
     {
@@ -875,7 +1202,7 @@ update_search_hl(
 	    *on_last_col = col + 1 >= shl->endcol;
 	}
 	if (shl != search_hl && cur != NULL)
-	    cur = cur->mit_next;
+	    cur = cur->mit_line_next;
     }
     // Only highlight one character after the last column.
     if (*(*line + col) == NUL && (did_line_attr >= 1
@@ -910,7 +1237,7 @@ get_prevcol_hl_flag(win_T *wp, match_T *search_hl, long curcol)
 	prevcol_hl_flag = TRUE;
     else
     {
-	cur = wp->w_match_head;
+	cur = wp->w_match_line_head;
 	while (cur != NULL)
 	{
 	    if (!cur->mit_hl.is_addpos && (prevcol == (long)cur->mit_hl.startcol
@@ -920,7 +1247,7 @@ get_prevcol_hl_flag(win_T *wp, match_T *search_hl, long curcol)
 		prevcol_hl_flag = TRUE;
 		break;
 	    }
-	    cur = cur->mit_next;
+	    cur = cur->mit_line_next;
 	}
     }
     return prevcol_hl_flag;
@@ -938,7 +1265,7 @@ get_search_match_hl(win_T *wp, match_T *search_hl, long col, int *char_attr)
     int		shl_flag;		// flag to indicate whether search_hl
 					// has been processed or not
 
-    cur = wp->w_match_head;
+    cur = wp->w_match_line_head;
     shl_flag = WIN_IS_POPUP(wp);
     while (cur != NULL || shl_flag == FALSE)
     {
@@ -956,7 +1283,7 @@ get_search_match_hl(win_T *wp, match_T *search_hl, long col, int *char_attr)
 		&& (shl == search_hl || !shl->is_addpos))
 	    *char_attr = shl->attr;
 	if (shl != search_hl && cur != NULL)
-	    cur = cur->mit_next;
+	    cur = cur->mit_line_next;
     }
 }
 
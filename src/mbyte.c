@@ -5747,6 +5747,7 @@ f_setcellwidths(typval_T *argvars, typval_T *rettv UNUSED)
     }
 
     vim_free(cw_table_save);
+    vcol_cache_clear();
     changed_window_setting_all();
     redraw_all_later(UPD_CLEAR);
 }
@@ -1319,7 +1319,7 @@ mf_do_open(
  * MHT_GROWTH_FACTOR when the average number of items per bucket
  * exceeds 2 ^ MHT_LOG_LOAD_FACTOR.
  */
-#define MHT_LOG_LOAD_FACTOR 6
+#define MHT_LOG_LOAD_FACTOR 1
 #define MHT_GROWTH_FACTOR   2   // must be a power of two
 
 /*
@@ -2864,7 +2864,189 @@ ml_line_alloced(void)
     return (curbuf->b_ml.ml_flags & ML_LINE_DIRTY);
 }
 
-#ifdef FEAT_PROP_POPUP
+/*
+ * Return TRUE if the bytes from "p" to "end" contain "text" with length "len".
+ */
+    static int
+ml_bytes_contain(char_u *p, char_u *end, char_u *text, int len)
+{
+    while (end - p >= len)
+    {
+	p = memchr(p, *text, end - p - len + 1);
+	if (p == NULL)
+	    return FALSE;
+	if (memcmp(p, text, len) == 0)
+	    return TRUE;
+	++p;
+    }
+    return FALSE;
+}
+
+/*
+ * Find the first line in buffer "buf", going from "lnum" to "lnum_end", that
+ * contains the bytes "text" with length "len".  Goes backwards when
+ * "lnum_end" is before "lnum".
+ * This looks at the text of a whole data block at once and skips the block
+ * when "text" is not in it, which is much faster than getting each line.
+ * Text properties are not skipped, thus the returned line may not actually
+ * contain "text".
+ * Checks for CTRL-C and the regexp timeout between blocks.  When interrupted
+ * or timed out returns the line reached, "*timed_out" is set for a timeout.
+ * Returns zero when "text" is not found.
+ */
+    linenr_T
+ml_find_text(
+    buf_T	*buf,
+    linenr_T	lnum,
+    linenr_T	lnum_end,
+    char_u	*text,
+    int		len,
+    int		*timed_out UNUSED)
+{
+    int		dir = lnum_end < lnum ? -1 : 1;
+    bhdr_T	*hp;
+    DATA_BL	*dp;
+    linenr_T	low;
+    linenr_T	first;
+    linenr_T	last;
+    linenr_T	l;
+    char_u	*start;
+    char_u	*end;
+
+    if (buf->b_ml.ml_mfp == NULL || lnum < 1
+					 || lnum > buf->b_ml.ml_line_count)
+	return lnum;
+
+    // The text of the cached line may not be in the data block yet.
+    ml_flush_line(buf);
+
+    while (dir > 0 ? lnum <= lnum_end : lnum >= lnum_end)
+    {
+	line_breakcheck();	// stop if ctrl-C typed
+	if (got_int)
+	    return lnum;
+#ifdef FEAT_RELTIME
+	if (regexp_timed_out())
+	{
+	    *timed_out = TRUE;
+	    return lnum;
+	}
+#endif
+
+	if ((hp = ml_find_line(buf, lnum, ML_FIND)) == NULL)
+	    return lnum;	// let the caller deal with the error
+	dp = (DATA_BL *)(hp->bh_data);
+	low = buf->b_ml.ml_locked_low;
+
+	// The lines in this block that are in the range, "first" <= "last".
+	if (dir > 0)
+	{
+	    first = lnum;
+	    last = MIN(buf->b_ml.ml_locked_high, lnum_end);
+	}
+	else
+	{
+	    first = MAX(low, lnum_end);
+	    last = lnum;
+	}
+
+	// Lines are stored from the end of the block backwards, the text of
+	// "last" comes first.
+	start = (char_u *)dp + (dp->db_index[last - low] & DB_INDEX_MASK);
+	end = (char_u *)dp + (first == low ? dp->db_txt_end
+			       : (dp->db_index[first - low - 1] & DB_INDEX_MASK));
+	if (ml_bytes_contain(start, end, text, len))
+	{
+	    for (l = lnum; dir > 0 ? l <= last : l >= first; l += dir)
+	    {
+		start = (char_u *)dp + (dp->db_index[l - low] & DB_INDEX_MASK);
+		end = (char_u *)dp + (l == low ? dp->db_txt_end
+				   : (dp->db_index[l - low - 1] & DB_INDEX_MASK));
+		if (ml_bytes_contain(start, end, text, len))
+		    return l;
+	    }
+	}
+	lnum = dir > 0 ? last + 1 : first - 1;
+    }
+    return 0;
+}
+
+#if defined(FEAT_PROP_POPUP) || defined(PROTO)
+/*
+ * Find the first line in buffer "buf", going from "lnum" to "lnum_end", that
+ * has text properties.  Goes backwards when "lnum_end" is before "lnum".
+ * Like ml_find_text() this looks at a whole data block at once.  A block
+ * found to have no text properties is flagged, so that it is skipped quickly
+ * until a line in it changes.
+ * Returns zero when there is no such line.
+ */
+    linenr_T
+ml_find_textprop(buf_T *buf, linenr_T lnum, linenr_T lnum_end)
+{
+    int		dir = lnum_end < lnum ? -1 : 1;
+    bhdr_T	*hp;
+    DATA_BL	*dp;
+    linenr_T	low;
+    linenr_T	high;
+    linenr_T	first;
+    linenr_T	last;
+    linenr_T	l;
+    char_u	*start;
+    char_u	*end;
+
+    if (!buf->b_has_textprop)
+	return 0;
+    if (buf->b_ml.ml_mfp == NULL || lnum < 1
+					 || lnum > buf->b_ml.ml_line_count)
+	return lnum;
+    // The caller may pass a range beyond the end of the buffer.
+    if (lnum_end > buf->b_ml.ml_line_count)
+	lnum_end = buf->b_ml.ml_line_count;
+    else if (lnum_end < 1)
+	lnum_end = 1;
+
+    // The cached line may have changed properties that are not in the data
+    // block yet.
+    ml_flush_line(buf);
+
+    while (dir > 0 ? lnum <= lnum_end : lnum >= lnum_end)
+    {
+	if ((hp = ml_find_line(buf, lnum, ML_FIND)) == NULL)
+	    return lnum;	// let the caller deal with the error
+	dp = (DATA_BL *)(hp->bh_data);
+	low = buf->b_ml.ml_locked_low;
+	high = buf->b_ml.ml_locked_high;
+
+	// The lines in this block that are in the range, "first" <= "last".
+	if (dir > 0)
+	{
+	    first = lnum;
+	    last = MIN(high, lnum_end);
+	}
+	else
+	{
+	    first = MAX(low, lnum_end);
+	    last = lnum;
+	}
+
+	if (!(hp->bh_flags & BH_NOPROPS))
+	{
+	    for (l = lnum; dir > 0 ? l <= last : l >= first; l += dir)
+	    {
+		start = (char_u *)dp + (dp->db_index[l - low] & DB_INDEX_MASK);
+		end = (char_u *)dp + (l == low ? dp->db_txt_end
+				   : (dp->db_index[l - low - 1] & DB_INDEX_MASK));
+		if ((size_t)(end - start) > STRLEN(start) + 1)
+		    return l;
+	    }
+	    if (first == low && last == high)
+		hp->bh_flags |= BH_NOPROPS;
+	}
+	lnum = dir > 0 ? last + 1 : first - 1;
+    }
+    return 0;
+}
+
 /*
  * Add text properties that continue from the previous line.
  */
@@ -3001,6 +3183,9 @@ ml_append_int(
     if ((hp = ml_find_line(buf, lnum == 0 ? (linenr_T)1 : lnum,
 							  ML_INSERT)) == NULL)
 	goto theend;
+#ifdef FEAT_PROP_POPUP
+    hp->bh_flags &= ~BH_NOPROPS;
+#endif
 
     buf->b_ml.ml_flags &= ~ML_EMPTY;
 
@@ -3032,6 +3217,9 @@ ml_append_int(
 	--(buf->b_ml.ml_locked_high);
 	if ((hp = ml_find_line(buf, lnum + 1, ML_INSERT)) == NULL)
 	    goto theend;
+#ifdef FEAT_PROP_POPUP
+	hp->bh_flags &= ~BH_NOPROPS;
+#endif
 
 	db_idx = -1;		    // careful, it is negative!
 		    // get line count before the insertion
@@ -4204,6 +4392,9 @@ ml_flush_line(buf_T *buf)
 		// copy new line into the data block
 		mch_memmove(old_line - extra, new_line, (size_t)new_len);
 		buf->b_ml.ml_flags |= (ML_LOCKED_DIRTY | ML_LOCKED_POS);
+#ifdef FEAT_PROP_POPUP
+		hp->bh_flags &= ~BH_NOPROPS;
+#endif
 #if defined(FEAT_BYTEOFF) && defined(FEAT_PROP_POPUP)
 		// The else case is already covered by the insert and delete
 		if (buf->b_has_textprop)
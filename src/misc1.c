@@ -25,6 +25,9 @@
 #define URL_SLASH	1		// path_is_url() has found "://"
 #define URL_BACKSLASH	2		// path_is_url() has found ":\\"
 
+// Maximum number of entries in w_plines_cache, it is cleared when full.
+#define PLINES_CACHE_MAX 10000
+
 // All user names (for ~user completion as done by shell).
 static garray_T	ga_users;
 
@@ -395,6 +398,119 @@ plines_win_nofill(
     return lines;
 }
 
+/*
+ * Clear the cached number of screen lines of window "wp".
+ */
+    void
+plines_cache_clear(win_T *wp)
+{
+    ga_clear(&wp->w_plines_cache.pc_ga);
+    wp->w_plines_cache.pc_buf = NULL;
+}
+
+/*
+ * Return the index of the first cached entry in "pc" for line "lnum" or a
+ * later line.
+ */
+    static int
+plines_cache_find_line(plinescache_T *pc, linenr_T lnum)
+{
+    plentry_T	*pe = (plentry_T *)pc->pc_ga.ga_data;
+    int		lo = 0;
+    int		hi = pc->pc_ga.ga_len;
+    int		mid;
+
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	if (pe[mid].pe_lnum < lnum)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Called by changed_common() for a change in the buffer of window "wp" from
+ * line "lnum" until "lnume" (not including), with "xtra" lines added.
+ * "old_tick" is b:changedtick from before the change.
+ * Drops the cached counts for the changed lines and adjusts the line number
+ * of the ones below them.
+ */
+    void
+plines_cache_changed(
+    win_T	*wp,
+    linenr_T	lnum,
+    linenr_T	lnume,
+    long	xtra,
+    varnumber_T	old_tick)
+{
+    plinescache_T   *pc = &wp->w_plines_cache;
+    plentry_T	    *pe;
+    int		    first;
+    int		    last;
+    int		    i;
+
+    if (pc->pc_buf == NULL)
+	return;
+    if (pc->pc_buf != wp->w_buffer || pc->pc_changedtick != old_tick
+		       || CHANGEDTICK(wp->w_buffer) != old_tick + 1)
+    {
+	plines_cache_clear(wp);
+	return;
+    }
+
+    pe = (plentry_T *)pc->pc_ga.ga_data;
+    first = plines_cache_find_line(pc, lnum);
+    last = plines_cache_find_line(pc, lnume);
+    if (last > first)
+    {
+	mch_memmove(pe + first, pe + last,
+			      sizeof(plentry_T) * (pc->pc_ga.ga_len - last));
+	pc->pc_ga.ga_len -= last - first;
+    }
+    if (xtra != 0)
+	for (i = first; i < pc->pc_ga.ga_len; ++i)
+	    pe[i].pe_lnum += xtra;
+    pc->pc_changedtick = CHANGEDTICK(wp->w_buffer);
+}
+
+/*
+ * Return the index in the cache of window "wp" for line "lnum", when the
+ * first screen line is "width" wide and further ones "width2".  Clears the
+ * cache when it is for another buffer, text or setting.
+ * Returns -1 when the count is not to be cached.
+ */
+    static int
+plines_cache_index(win_T *wp, linenr_T lnum, int width, int width2)
+{
+    plinescache_T   *pc = &wp->w_plines_cache;
+    buf_T	    *buf = wp->w_buffer;
+
+#ifdef FEAT_PROP_POPUP
+    // Adding or removing virtual text does not change b:changedtick.
+    if (buf->b_textprop_text.ga_len > 0)
+	return -1;
+#endif
+    if (pc->pc_buf != buf
+	    || pc->pc_changedtick != CHANGEDTICK(buf)
+	    || pc->pc_setting_tick != display_setting_tick
+	    || pc->pc_width != width
+	    || pc->pc_width2 != width2
+	    || pc->pc_ga.ga_len >= PLINES_CACHE_MAX)
+    {
+	plines_cache_clear(wp);
+	ga_init2(&pc->pc_ga, sizeof(plentry_T), 100);
+	pc->pc_buf = buf;
+	pc->pc_changedtick = CHANGEDTICK(buf);
+	pc->pc_setting_tick = display_setting_tick;
+	pc->pc_width = width;
+	pc->pc_width2 = width2;
+    }
+    return plines_cache_find_line(pc, lnum);
+}
+
 /*
  * Return number of window lines physical line "lnum" will occupy in window
  * "wp".  Does not care about folding, 'wrap' or 'diff'.
@@ -405,8 +521,25 @@ plines_win_nofold(win_T *wp, linenr_T lnum)
     char_u	*s;
     long	col;
     int		width;
+    int		width2;
+    int		lines;
+    int		idx;
+    plentry_T	*pe;
     chartabsize_T cts;
 
+    /*
+     * Add column offset for 'number', 'relativenumber' and 'foldcolumn'.
+     */
+    width = wp->w_width - win_col_off(wp);
+    width2 = width + win_col_off2(wp);
+
+    // Use the cached count if possible.
+    idx = width <= 0 ? -1 : plines_cache_index(wp, lnum, width, width2);
+    pe = (plentry_T *)wp->w_plines_cache.pc_ga.ga_data;
+    if (idx >= 0 && idx < wp->w_plines_cache.pc_ga.ga_len
+						 && pe[idx].pe_lnum == lnum)
+	return pe[idx].pe_lines;
+
     s = ml_get_buf(wp->w_buffer, lnum, FALSE);
     init_chartabsize_arg(&cts, wp, lnum, 0, s, s);
     if (*s == NUL
@@ -414,27 +547,37 @@ plines_win_nofold(win_T *wp, linenr_T lnum)
 	    && !cts.cts_has_prop_with_text
 #endif
 	    )
-	return 1; // be quick for an empty line
-    win_linetabsize_cts(&cts, (colnr_T)MAXCOL);
+	lines = 1; // be quick for an empty line
+    else
+    {
+	if (!linetabsize_cached(&cts, lnum))
+	    win_linetabsize_cts(&cts, (colnr_T)MAXCOL);
+	col = (int)cts.cts_vcol;
+
+	// If list mode is on, then the '$' at the end of the line may take up
+	// one extra column.
+	if (wp->w_p_list && wp->w_lcs_chars.eol != NUL)
+	    col += 1;
+
+	if (width <= 0)
+	    lines = 32000;
+	else if (col <= width)
+	    lines = 1;
+	else
+	    lines = (col - width + (width2 - 1)) / width2 + 1;
+    }
     clear_chartabsize_arg(&cts);
-    col = (int)cts.cts_vcol;
-
-    // If list mode is on, then the '$' at the end of the line may take up one
-    // extra column.
-    if (wp->w_p_list && wp->w_lcs_chars.eol != NUL)
-	col += 1;
 
-    /*
-     * Add column offset for 'number', 'relativenumber' and 'foldcolumn'.
-     */
-    width = wp->w_width - win_col_off(wp);
-    if (width <= 0)
-	return 32000;
-    if (col <= width)
-	return 1;
-    col -= width;
-    width += win_col_off2(wp);
-    return (col + (width - 1)) / width + 1;
+    if (idx >= 0 && ga_grow(&wp->w_plines_cache.pc_ga, 1) == OK)
+    {
+	pe = (plentry_T *)wp->w_plines_cache.pc_ga.ga_data + idx;
+	mch_memmove(pe + 1, pe, sizeof(plentry_T)
+				  * (wp->w_plines_cache.pc_ga.ga_len - idx));
+	pe->pe_lnum = lnum;
+	pe->pe_lines = lines;
+	++wp->w_plines_cache.pc_ga.ga_len;
+    }
+    return lines;
 }
 
 /*
@@ -768,6 +911,9 @@ f_mode(typval_T *argvars, typval_T *rettv)
 	return;
 
     get_mode(buf);
+#ifdef FEAT_STL_OPT
+    stl_uses_mode = TRUE;
+#endif
 
     // Clear out the minor mode when the argument is not a non-zero number or
     // non-empty string.
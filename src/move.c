@@ -656,6 +656,8 @@ changed_window_setting(void)
     void
 changed_window_setting_win(win_T *wp)
 {
+    // The setting may be global or for a buffer shown in other windows.
+    ++display_setting_tick;
     wp->w_lines_valid = 0;
     changed_line_abv_curs_win(wp);
     wp->w_valid &= ~(VALID_BOTLINE|VALID_BOTLINE_AP|VALID_TOPLINE);
@@ -771,6 +773,7 @@ changed_line_display_buf(buf_T *buf)
 {
     win_T *wp;
 
+    ++display_setting_tick;
     FOR_ALL_WINDOWS(wp)
 	if (wp->w_buffer == buf)
 	    wp->w_valid &= ~(VALID_WROW|VALID_WCOL|VALID_VIRTCOL
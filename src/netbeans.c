@@ -3112,6 +3112,7 @@ netbeans_gutter_click(linenr_T lnum)
 	    sign_entry_T *tail;
 
 	    // remove "p" from list, reinsert it at the tail of the sublist
+	    curbuf->b_signindex_valid = FALSE;
 	    if (p->se_prev)
 		p->se_prev->se_next = p->se_next;
 	    else
@@ -1037,6 +1037,7 @@ did_set_ambiwidth(optset_T *args UNUSED)
     if (check_opt_strings(p_ambw, p_ambw_values, FALSE) != OK)
 	return e_invalid_argument;
 
+    vcol_cache_clear();
     return check_chars_options();
 }
 
@@ -3699,6 +3700,8 @@ expand_set_tabclose(optexpand_T *args, int *numMatches, char_u ***matches)
     char *
 did_set_tabline(optset_T *args)
 {
+    // It is not known yet whether the new value uses the current mode.
+    tabline_uses_mode = TRUE;
     return parse_statustabline_rulerformat(args, FALSE);
 }
 #endif
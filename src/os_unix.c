@@ -426,13 +426,145 @@ mch_chdir(char *path)
 # define NEW_TTY_SYSTEM
 #endif
 
+// Output that the terminal did not accept yet, see out_flush_nowait().
+static garray_T write_pending = GA_EMPTY;
+
+// When more than this is pending, wait for the terminal to accept it.
+#define WRITE_PENDING_MAX (256 * 1024)
+
+// Number of bytes written at a time when not waiting.  A terminal that is
+// ready for writing accepts at least this much without blocking.
+#define WRITE_NOWAIT_CHUNK 512
+
+/*
+ * Return TRUE when stdout is ready for writing without blocking.
+ */
+    static int
+stdout_writable(void)
+{
+# ifndef HAVE_SELECT
+    struct pollfd   fds;
+
+    fds.fd = 1;
+    fds.events = POLLOUT;
+    return poll(&fds, 1, 0) > 0 && (fds.revents & POLLOUT);
+# else
+    fd_set	    wfds;
+    struct timeval  tv;
+
+    FD_ZERO(&wfds);
+    FD_SET(1, &wfds);
+    tv.tv_sec = 0;
+    tv.tv_usec = 0;
+    return select(2, NULL, SELECT_TYPE_ARG234 &wfds, NULL, &tv) > 0;
+# endif
+}
+
+/*
+ * Write "len" bytes from "s" to stdout.  When "nowait" is TRUE return when
+ * the terminal does not accept more without blocking.  The file descriptor
+ * is not made non-blocking, it may be shared with other processes.
+ * Returns the number of bytes written, -1 for an error.
+ */
+    static int
+write_stdout(char_u *s, int len, int nowait)
+{
+    int		done = 0;
+    int		n;
+
+    // A screen update can be written at once, which may take more than one
+    // write() when it is interrupted by a signal.  When not waiting write
+    // small chunks, as long as the terminal is ready for them.
+    while (done < len)
+    {
+	if (nowait && !stdout_writable())
+	    break;
+	n = len - done;
+	if (nowait && n > WRITE_NOWAIT_CHUNK)
+	    n = WRITE_NOWAIT_CHUNK;
+	n = (int)write(1, (char *)s + done, n);
+	if (n <= 0)
+	{
+# ifdef EINTR
+	    if (n < 0 && errno == EINTR)
+		continue;
+# endif
+	    if (n < 0)
+		done = -1;
+	    break;
+	}
+	done += n;
+    }
+    return done;
+}
+
+/*
+ * Write output that the terminal did not accept yet.  When "wait" is TRUE
+ * wait until all of it is written, otherwise write what can be written
+ * without blocking.
+ */
+    void
+mch_write_pending(int wait)
+{
+    int		n;
+
+    if (write_pending.ga_len == 0)
+	return;
+    n = write_stdout((char_u *)write_pending.ga_data, write_pending.ga_len,
+									!wait);
+    if (n < 0 || n == write_pending.ga_len)
+	// written or an error: the rest won't get through either
+	ga_clear(&write_pending);
+    else if (n > 0)
+    {
+	write_pending.ga_len -= n;
+	mch_memmove(write_pending.ga_data, (char_u *)write_pending.ga_data + n,
+						  (size_t)write_pending.ga_len);
+    }
+}
+
 /*
  * Write s[len] to the screen (stdout).
+ * When "write_nowait" is set and the terminal is slow, what it does not
+ * accept is kept and written while waiting for a character.
  */
     void
 mch_write(char_u *s, int len)
 {
-    vim_ignored = (int)write(1, (char *)s, len);
+    int		n;
+
+    if (write_pending.ga_len > 0)
+    {
+	// Keep the order: append to what is still pending.  Without memory
+	// for that wait for the pending output to be written.
+	if (write_nowait && ga_grow(&write_pending, len) == OK)
+	{
+	    mch_memmove((char_u *)write_pending.ga_data + write_pending.ga_len,
+								       s, len);
+	    write_pending.ga_len += len;
+	    len = 0;
+	}
+	mch_write_pending(len > 0 || !write_nowait
+				 || write_pending.ga_len > WRITE_PENDING_MAX);
+    }
+
+    if (len > 0)
+    {
+	n = write_stdout(s, len, write_nowait);
+	if (n >= 0 && n < len)
+	{
+	    // The terminal is busy, write the rest later.
+	    ga_init2(&write_pending, 1, 4000);
+	    if (ga_grow(&write_pending, len - n) == OK)
+	    {
+		mch_memmove(write_pending.ga_data, s + n, len - n);
+		write_pending.ga_len = len - n;
+	    }
+	    else
+		(void)write_stdout(s + n, len - n, FALSE);
+	}
+    }
+
     if (p_wd)		// Unix is too fast, slow down a bit more
 	RealWaitForChar(read_cmd_fd, p_wd, NULL, NULL);
 }
@@ -6389,11 +6521,8 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
     int		result;
 #if defined(FEAT_XCLIPBOARD) || defined(USE_XSMP) || defined(FEAT_MZSCHEME)
     static int	busy = FALSE;
-
-    // May retry getting characters after an event was handled.
-# define MAY_LOOP
-
-# ifdef ELAPSED_FUNC
+#endif
+#ifdef ELAPSED_FUNC
     // Remember at what time we started, so that we know how much longer we
     // should wait after being interrupted.
     long	start_msec = msec;
@@ -6401,23 +6530,22 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
 
     if (msec > 0)
 	ELAPSED_INIT(start_tv);
-# endif
+#endif
 
+#if defined(FEAT_XCLIPBOARD) || defined(USE_XSMP) || defined(FEAT_MZSCHEME)
     // Handle being called recursively.  This may happen for the session
     // manager stuff, it may save the file, which does a breakcheck.
     if (busy)
 	return 0;
 #endif
 
-#ifdef MAY_LOOP
+    // May retry getting characters after an event was handled or pending
+    // output was written.
     for (;;)
-#endif
     {
-#ifdef MAY_LOOP
 	int		finished = TRUE; // default is to 'loop' just once
-# ifdef FEAT_MZSCHEME
+#ifdef FEAT_MZSCHEME
 	int		mzquantum_used = FALSE;
-# endif
 #endif
 #ifndef HAVE_SELECT
 			// each channel may use in, out and err
@@ -6432,6 +6560,7 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
 # ifdef USE_XSMP
 	int		xsmp_idx = -1;
 # endif
+	int		out_idx = -1;
 	int		towait = (int)msec;
 
 # ifdef FEAT_MZSCHEME
@@ -6474,6 +6603,14 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
 	    nfd++;
 	}
 # endif
+	if (write_pending.ga_len > 0)
+	{
+	    // write the rest of the output when the terminal accepts it
+	    out_idx = nfd;
+	    fds[nfd].fd = 1;
+	    fds[nfd].events = POLLOUT;
+	    nfd++;
+	}
 #ifdef FEAT_JOB_CHANNEL
 	nfd = channel_poll_setup(nfd, &fds, &towait);
 #endif
@@ -6524,6 +6661,17 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
 		finished = FALSE;	// Try again
 	}
 # endif
+	if (out_idx >= 0 && fds[out_idx].revents != 0)
+	{
+	    mch_write_pending(FALSE);
+	    if (--ret == 0)
+	    {
+		// Only the output was written, keep waiting.
+		if (interrupted != NULL)
+		    *interrupted = FALSE;
+		finished = FALSE;
+	    }
+	}
 #ifdef FEAT_JOB_CHANNEL
 	// also call when ret == 0, we may be polling a keep-open channel
 	if (ret >= 0)
@@ -6538,6 +6686,7 @@ RealWaitForChar(int fd, long msec, int *check_for_gpm UNUSED, int *interrupted)
 	// signal stack to run out with -O3.
 	static fd_set	rfds, wfds, efds;
 	int		maxfd;
+	int		out_pending = write_pending.ga_len > 0;
 	long		towait = msec;
 
 # ifdef FEAT_MZSCHEME
@@ -6603,6 +6752,13 @@ select_eintr:
 		maxfd = xsmp_icefd;
 	}
 # endif
+	if (out_pending)
+	{
+	    // write the rest of the output when the terminal accepts it
+	    FD_SET(1, &wfds);
+	    if (maxfd < 1)
+		maxfd = 1;
+	}
 # ifdef FEAT_JOB_CHANNEL
 	maxfd = channel_select_setup(maxfd, &rfds, &wfds, &tv, &tvp);
 # endif
@@ -6705,6 +6861,17 @@ select_eintr:
 	    }
 	}
 # endif
+	if (ret > 0 && out_pending && FD_ISSET(1, &wfds))
+	{
+	    mch_write_pending(FALSE);
+	    if (--ret == 0 && !result)
+	    {
+		// Only the output was written, keep waiting.
+		if (interrupted != NULL)
+		    *interrupted = FALSE;
+		finished = FALSE;
+	    }
+	}
 #ifdef FEAT_JOB_CHANNEL
 	// also call when ret == 0, we may be polling a keep-open channel
 	if (ret >= 0)
@@ -6713,7 +6880,6 @@ select_eintr:
 
 #endif // HAVE_SELECT
 
-#ifdef MAY_LOOP
 	if (finished || msec == 0)
 	    break;
 
@@ -6735,7 +6901,6 @@ select_eintr:
 	    if (msec <= 0)
 		break;	// waited long enough
 	}
-#endif
     }
 
     return result;
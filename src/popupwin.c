@@ -2014,6 +2014,17 @@ popup_update_color(win_T *wp, create_type_T type)
 		OPT_FREE|OPT_LOCAL, 0);
 }
 
+/*
+ * The intro message is not in a window, the changed popup mask does not cause
+ * it to be redrawn.  Redraw everything when it may be on the screen.
+ */
+    static void
+popup_may_clear_intro(void)
+{
+    if (intro_message_wanted())
+	redraw_all_later(UPD_NOT_VALID);
+}
+
 /*
  * popup_create({text}, {options})
  * popup_atcursor({text}, {options})
@@ -2317,7 +2328,9 @@ popup_create(typval_T *argvars, typval_T *rettv, create_type_T type)
 
     wp->w_vsep_width = 0;
 
-    redraw_all_later(UPD_NOT_VALID);
+    // Only the popup needs to be drawn, the text below it is not visible.
+    redraw_win_later(wp, UPD_NOT_VALID);
+    popup_may_clear_intro();
     popup_mask_refresh = TRUE;
 
 #ifdef FEAT_TERMINAL
@@ -2756,7 +2769,9 @@ popup_hide(win_T *wp)
 
     wp->w_popup_flags |= POPF_HIDDEN;
     // Do not decrement b_nwindows, we still reference the buffer.
-    redraw_all_later(UPD_NOT_VALID);
+    // What was behind the popup is redrawn when updating popup_mask.
+    set_must_redraw(UPD_VALID);
+    popup_may_clear_intro();
     popup_mask_refresh = TRUE;
 }
 
@@ -2788,7 +2803,10 @@ popup_show(win_T *wp)
 	return;
 
     wp->w_popup_flags &= ~POPF_HIDDEN;
-    redraw_all_later(UPD_NOT_VALID);
+    redraw_win_later(wp, UPD_NOT_VALID);
+    // w_redr_type may have been set while the popup was hidden
+    set_must_redraw(UPD_VALID);
+    popup_may_clear_intro();
     popup_mask_refresh = TRUE;
 }
 
@@ -2906,7 +2924,9 @@ popup_free(win_T *wp)
 	message_win = NULL;
 #endif
 
-    redraw_all_later(UPD_NOT_VALID);
+    // What was behind the popup is redrawn when updating popup_mask.
+    set_must_redraw(UPD_VALID);
+    popup_may_clear_intro();
     popup_mask_refresh = TRUE;
 }
 
@@ -3802,11 +3822,14 @@ check_popup_unhidden(win_T *wp)
  * That is when the buffer in the popup was changed, or the popup is following
  * a textprop and the referenced buffer was changed.
  * Or when the cursor line changed and "cursorline" is set.
+ * Or when the popup is to be redrawn, the text may have changed without
+ * changing b:changedtick.
  */
     static int
 popup_need_position_adjust(win_T *wp)
 {
-    if (wp->w_popup_last_changedtick != CHANGEDTICK(wp->w_buffer))
+    if (wp->w_popup_last_changedtick != CHANGEDTICK(wp->w_buffer)
+	    || wp->w_redr_type >= UPD_NOT_VALID)
 	return TRUE;
     if (win_valid(wp->w_popup_prop_win)
 	    && (wp->w_popup_prop_changedtick
@@ -3818,6 +3841,31 @@ popup_need_position_adjust(win_T *wp)
     return wp->w_cursor.lnum != wp->w_popup_last_curline;
 }
 
+/*
+ * Mark the visible popup window with "zindex" at screen position "line" /
+ * "col" for redrawing, what was on top of it has gone.
+ */
+    static void
+popup_redraw_at(int line, int col, int zindex)
+{
+    win_T	*wp;
+
+    FOR_ALL_POPUPWINS(wp)
+	if (wp->w_zindex == zindex && (wp->w_popup_flags & POPF_HIDDEN) == 0
+		&& line >= wp->w_winrow
+		&& line < wp->w_winrow + popup_height(wp)
+		&& col >= wp->w_wincol
+		&& col < wp->w_wincol + popup_width(wp))
+	    redraw_win_later(wp, UPD_NOT_VALID);
+    FOR_ALL_POPUPWINS_IN_TAB(curtab, wp)
+	if (wp->w_zindex == zindex && (wp->w_popup_flags & POPF_HIDDEN) == 0
+		&& line >= wp->w_winrow
+		&& line < wp->w_winrow + popup_height(wp)
+		&& col >= wp->w_wincol
+		&& col < wp->w_wincol + popup_width(wp))
+	    redraw_win_later(wp, UPD_NOT_VALID);
+}
+
 /*
  * Update "popup_mask" if needed.
  * Also recomputes the popup size and positions.
@@ -3923,6 +3971,7 @@ may_update_popup_mask(int type)
 	for (line = 0; line < screen_Rows; ++line)
 	{
 	    int	    col_done = 0;
+	    int	    zindex_done = 0;
 
 	    for (col = 0; col < screen_Columns; ++col)
 	    {
@@ -3932,6 +3981,16 @@ may_update_popup_mask(int type)
 		{
 		    popup_mask[off] = popup_mask_next[off];
 
+		    // A popup below the one that was here needs to be
+		    // redrawn.
+		    if (popup_mask_next[off] != 0
+			    && popup_mask_next[off] != POPUPMENU_ZINDEX
+			    && popup_mask_next[off] != zindex_done)
+		    {
+			zindex_done = popup_mask_next[off];
+			popup_redraw_at(line, col, zindex_done);
+		    }
+
 		    if (line >= cmdline_row)
 		    {
 			// the command line needs to be cleared if text below
@@ -3939,6 +3998,8 @@ may_update_popup_mask(int type)
 			if (!msg_scrolled && popup_mask_next[off] == 0)
 			    clear_cmdline = TRUE;
 		    }
+		    else if (line < tabline_height())
+			redraw_tabline = TRUE;
 		    else if (col >= col_done)
 		    {
 			linenr_T	lnum;
@@ -24,4 +24,9 @@ void status_redraw_curbuf(void);
 void redraw_statuslines(void);
 void win_redraw_last_status(frame_T *frp);
 void redrawWinline(win_T *wp, linenr_T lnum);
+void drawtime_add(int phase, proftime_T *tm);
+void drawtime_add_lines(win_T *wp, long count);
+void ex_drawtime(exarg_T *eap);
+char_u *get_drawtime_arg(expand_T *xp, int idx);
+void f_getdrawtime(typval_T *argvars, typval_T *rettv);
 /* vim: set ft=c : */
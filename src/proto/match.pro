@@ -1,5 +1,7 @@
 /* match.c */
 void clear_matches(win_T *wp);
+void match_cache_clear(win_T *wp);
+void match_cache_changed(win_T *wp, linenr_T lnum, linenr_T lnume, long xtra, varnumber_T old_tick);
 void init_search_hl(win_T *wp, match_T *search_hl);
 void prepare_search_hl(win_T *wp, match_T *search_hl, linenr_T lnum);
 int prepare_search_hl_line(win_T *wp, linenr_T lnum, colnr_T mincol, char_u **line, match_T *search_hl, int *search_attr);
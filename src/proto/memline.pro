@@ -26,6 +26,8 @@ colnr_T ml_get_cursor_len(void);
 colnr_T ml_get_buf_len(buf_T *buf, linenr_T lnum);
 char_u *ml_get_buf(buf_T *buf, linenr_T lnum, int will_change);
 int ml_line_alloced(void);
+linenr_T ml_find_text(buf_T *buf, linenr_T lnum, linenr_T lnum_end, char_u *text, int len, int *timed_out);
+linenr_T ml_find_textprop(buf_T *buf, linenr_T lnum, linenr_T lnum_end);
 int ml_append(linenr_T lnum, char_u *line, colnr_T len, int newfile);
 int ml_append_flags(linenr_T lnum, char_u *line, colnr_T len, int flags);
 int ml_append_buf(buf_T *buf, linenr_T lnum, char_u *line, colnr_T len, int newfile);
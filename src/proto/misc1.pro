@@ -5,6 +5,8 @@ int plines(linenr_T lnum);
 int plines_win(win_T *wp, linenr_T lnum, int limit_winheight);
 int plines_nofill(linenr_T lnum);
 int plines_win_nofill(win_T *wp, linenr_T lnum, int limit_winheight);
+void plines_cache_clear(win_T *wp);
+void plines_cache_changed(win_T *wp, linenr_T lnum, linenr_T lnume, long xtra, varnumber_T old_tick);
 int plines_win_nofold(win_T *wp, linenr_T lnum);
 int plines_win_col(win_T *wp, linenr_T lnum, long column);
 int plines_m_win(win_T *wp, linenr_T first, linenr_T last, int max);
@@ -1,9 +1,13 @@
 /* regexp.c */
 void init_regexp_timeout(long msec);
 void disable_regexp_timeout(void);
+int regexp_timed_out(void);
 void save_timeout_for_debugging(void);
 void restore_timeout_for_debugging(void);
 int re_multiline(regprog_T *prog);
+int re_linelocal(char_u *pat, regprog_T *prog);
+char_u *re_required_text(regprog_T *prog, int ic, int *lenp);
+char_u *re_start_bytes(regprog_T *prog, int ic);
 char_u *skip_regexp(char_u *startp, int delim, int magic);
 char_u *skip_regexp_err(char_u *startp, int delim, int magic);
 char_u *skip_regexp_ex(char_u *startp, int dirc, int magic, char_u **newp, int *dropped, magic_T *magic_val);
@@ -18,6 +18,7 @@ void set_last_csearch(int c, char_u *s, int len);
 void set_csearch_direction(int cdir);
 void set_csearch_until(int t_cmd);
 char_u *last_search_pat(void);
+int last_search_pat_magic(void);
 void reset_search_dir(void);
 void set_last_search_pat(char_u *s, int idx, int magic, int setlast);
 void last_pat_prog(regmmatch_T *regmatch);
@@ -32,6 +33,8 @@ int check_linecomment(char_u *line);
 void showmatch(int c);
 int current_search(long count, int forward);
 int linewhite(linenr_T lnum);
+void search_count_clear(buf_T *buf);
+void search_count_changed(buf_T *buf, linenr_T lnum, linenr_T lnume, long xtra, varnumber_T old_tick);
 void find_pattern_in_path(char_u *ptr, int dir, int len, int whole, int skip_comments, int type, long count, int action, linenr_T start_lnum, linenr_T end_lnum, int forceit);
 spat_T *get_spat(int idx);
 int get_spat_last_idx(void);
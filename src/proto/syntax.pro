@@ -1,6 +1,10 @@
 /* syntax.c */
 void syntax_start(win_T *wp, linenr_T lnum);
+int syntax_idle_parse(void);
+linenr_T syn_last_state_lnum(win_T *wp);
 void syn_stack_free_all(synblock_T *block);
+void syn_stack_save(buf_T *buf, synsave_T *ssp);
+void syn_stack_restore(buf_T *buf, synsave_T *ssp, linenr_T lnum);
 void syn_stack_apply_changes(buf_T *buf);
 void syntax_end_parsing(win_T *wp, linenr_T lnum);
 int syntax_check_changed(linenr_T lnum);
@@ -78,6 +78,16 @@ disable_regexp_timeout(void)
 	timeout_flag = &dummy_timeout_flag;
     }
 }
+
+/*
+ * Return TRUE when the timer set with init_regexp_timeout() has expired.
+ * For code that skips over text before a regexp is executed.
+ */
+    int
+regexp_timed_out(void)
+{
+    return *timeout_flag != 0;
+}
 #endif
 
 #if defined(FEAT_EVAL) || defined(PROTO)
@@ -452,6 +462,82 @@ re_multiline(regprog_T *prog)
     return (prog->regflags & RF_HASNL);
 }
 
+/*
+ * Return TRUE if a match of "pat", compiled into "prog", only depends on the
+ * text of the line it is in.  Not when it can match a line break or uses an
+ * item that checks the position, such as "\%23l", "\%V", "\%#" or "\%^".
+ * Errs on the safe side: "%" in a collection is also seen as such an item.
+ */
+    int
+re_linelocal(char_u *pat, regprog_T *prog)
+{
+    char_u	*p;
+
+    if (prog == NULL || re_multiline(prog))
+	return FALSE;
+    for (p = pat; *p != NUL; ++p)
+	if (*p == '%' && p[1] != NUL
+			    && vim_strchr((char_u *)"0123456789<>#'.V^$", p[1])
+								      != NULL)
+	    return FALSE;
+    return TRUE;
+}
+
+/*
+ * Return literal text that every match of "prog" contains, exactly as it is
+ * in the buffer, and set "*lenp" to its length in bytes.  "ic" is the
+ * 'ignorecase' value the pattern is used with.
+ * Returns NULL when there is no such text, or it cannot be used without
+ * regexp rules, e.g. when ignoring case or when a match can start in another
+ * line.  The text is owned by "prog", it is freed together with it.
+ */
+    char_u *
+re_required_text(regprog_T *prog, int ic, int *lenp)
+{
+    char_u	*text = NULL;
+    int		len = 0;
+
+    if (prog == NULL
+	    || (prog->regflags & (RF_ICASE | RF_HASNL | RF_ICOMBINE | RF_LOOKBH))
+	    || (ic && !(prog->regflags & RF_NOICASE)))
+	return NULL;
+    if (prog->engine == &bt_regengine)
+    {
+	text = ((bt_regprog_T *)prog)->regmust;
+	len = ((bt_regprog_T *)prog)->regmlen;
+    }
+    else if (prog->engine == &nfa_regengine)
+    {
+	// "match_text" is set when the pattern is only literal text, without
+	// the first character.
+	text = ((nfa_regprog_T *)prog)->match_text;
+	if (text != NULL)
+	    len = (int)STRLEN(text);
+    }
+    if (text == NULL || len == 0)
+	return NULL;
+    *lenp = len;
+    return text;
+}
+
+/*
+ * Return a bit array with a bit set for each byte that a match of "prog" can
+ * start with, as it is in the buffer: bit "b & 7" of byte "b >> 3" for byte
+ * "b".  "ic" is the 'ignorecase' value the pattern is used with.
+ * Returns NULL when the bytes are not known, same restrictions as for
+ * re_required_text().  The array is owned by "prog".
+ */
+    char_u *
+re_start_bytes(regprog_T *prog, int ic)
+{
+    if (prog == NULL
+	    || (prog->regflags & (RF_ICASE | RF_HASNL | RF_ICOMBINE | RF_LOOKBH))
+	    || (ic && !(prog->regflags & RF_NOICASE))
+	    || prog->engine != &nfa_regengine)
+	return NULL;
+    return ((nfa_regprog_T *)prog)->start_bytes;
+}
+
 /*
  * Check for an equivalence class name "[=a=]".  "pp" points to the '['.
  * Returns a character representing the class. Zero means that no item was
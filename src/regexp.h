@@ -111,6 +111,8 @@ typedef struct
     int			reganch;	// pattern starts with ^
     int			regstart;	// char at start of pattern
     char_u		*match_text;	// plain text to match with
+    char_u		*start_bytes;	// bit set for each byte a match can
+					// start with, NULL if not known
 
     int			has_zend;	// pattern contains \ze
     int			has_backref;	// pattern contains \1 .. \9
@@ -270,6 +270,7 @@ static void nfa_print_state2(FILE *debugf, nfa_state_T *state, garray_T *indent)
 #endif
 static int match_follows(nfa_state_T *startstate, int depth);
 static int failure_chance(nfa_state_T *state, int depth);
+static int check_char_class(int class, int c);
 
 // helper functions used when doing re2post() ... regatom() parsing
 #define EMIT(c)	do {				\
@@ -504,6 +505,194 @@ nfa_get_match_text(nfa_state_T *start)
     return ret;
 }
 
+/*
+ * Set the bit in "bytes" for the first byte of character "c".  For a
+ * multi-byte character all bytes from 0x80 are set when "all_high" is TRUE.
+ */
+    static void
+nfa_add_start_byte(int c, char_u *bytes, int all_high)
+{
+    char_u	buf[MB_MAXBYTES + 1];
+
+    if (c >= 0x80 && has_mbyte)
+    {
+	if (all_high)
+	{
+	    vim_memset(bytes + (0x80 >> 3), 0xff, 0x80 >> 3);
+	    return;
+	}
+	(*mb_char2bytes)(c, buf);
+	c = buf[0];
+    }
+    if (c > 0 && c < 0x100)
+	bytes[c >> 3] |= 1 << (c & 7);
+}
+
+/*
+ * Find the bytes that a match starting at state "start" can start with and
+ * set their bits in "bytes".  "budget" limits the number of states looked at.
+ * Returns FAIL when it cannot be figured out, e.g. when the pattern can
+ * match an empty string.
+ */
+    static int
+nfa_collect_start_bytes(nfa_state_T *start, char_u *bytes, int *budget)
+{
+    nfa_state_T *p = start;
+    int		c;
+
+    while (p != NULL)
+    {
+	if (--*budget < 0)
+	    return FAIL;
+	switch (p->c)
+	{
+	    // all kinds of zero-width matches
+	    case NFA_BOL:
+	    case NFA_BOF:
+	    case NFA_BOW:
+	    case NFA_EOW:
+	    case NFA_ZSTART:
+	    case NFA_ZEND:
+	    case NFA_EMPTY:
+
+	    case NFA_MOPEN:
+	    case NFA_MOPEN1:
+	    case NFA_MOPEN2:
+	    case NFA_MOPEN3:
+	    case NFA_MOPEN4:
+	    case NFA_MOPEN5:
+	    case NFA_MOPEN6:
+	    case NFA_MOPEN7:
+	    case NFA_MOPEN8:
+	    case NFA_MOPEN9:
+	    case NFA_NOPEN:
+	    case NFA_MCLOSE:
+	    case NFA_MCLOSE1:
+	    case NFA_MCLOSE2:
+	    case NFA_MCLOSE3:
+	    case NFA_MCLOSE4:
+	    case NFA_MCLOSE5:
+	    case NFA_MCLOSE6:
+	    case NFA_MCLOSE7:
+	    case NFA_MCLOSE8:
+	    case NFA_MCLOSE9:
+	    case NFA_NCLOSE:
+#ifdef FEAT_SYN_HL
+	    case NFA_ZOPEN:
+	    case NFA_ZOPEN1:
+	    case NFA_ZOPEN2:
+	    case NFA_ZOPEN3:
+	    case NFA_ZOPEN4:
+	    case NFA_ZOPEN5:
+	    case NFA_ZOPEN6:
+	    case NFA_ZOPEN7:
+	    case NFA_ZOPEN8:
+	    case NFA_ZOPEN9:
+	    case NFA_ZCLOSE:
+	    case NFA_ZCLOSE1:
+	    case NFA_ZCLOSE2:
+	    case NFA_ZCLOSE3:
+	    case NFA_ZCLOSE4:
+	    case NFA_ZCLOSE5:
+	    case NFA_ZCLOSE6:
+	    case NFA_ZCLOSE7:
+	    case NFA_ZCLOSE8:
+	    case NFA_ZCLOSE9:
+#endif
+		p = p->out;
+		break;
+
+	    case NFA_SPLIT:
+		if (nfa_collect_start_bytes(p->out, bytes, budget) == FAIL)
+		    return FAIL;
+		p = p->out1;
+		break;
+
+	    case NFA_WHITE:
+	    case NFA_DIGIT:
+	    case NFA_HEX:
+	    case NFA_OCTAL:
+	    case NFA_WORD:
+	    case NFA_HEAD:
+	    case NFA_ALPHA:
+	    case NFA_LOWER_IC:
+	    case NFA_UPPER_IC:
+		for (c = 1; c < 0x100; ++c)
+		    if (p->c == NFA_WHITE ? VIM_ISWHITE(c)
+			    : p->c == NFA_DIGIT ? ri_digit(c)
+			    : p->c == NFA_HEX ? ri_hex(c)
+			    : p->c == NFA_OCTAL ? ri_octal(c)
+			    : p->c == NFA_WORD ? ri_word(c)
+			    : p->c == NFA_HEAD ? ri_head(c)
+			    : p->c == NFA_ALPHA ? ri_alpha(c)
+			    : p->c == NFA_LOWER_IC ? ri_lower(c)
+			    : ri_upper(c))
+			nfa_add_start_byte(c, bytes, TRUE);
+		return OK;
+
+	    case NFA_START_COLL:
+		// A list of characters and ranges until NFA_END_COLL.
+		for (p = p->out; p->c != NFA_END_COLL; p = p->out)
+		{
+		    if (--*budget < 0)
+			return FAIL;
+		    if (p->c == NFA_RANGE_MIN)
+		    {
+			int c2 = p->out->val;
+
+			for (c = p->val; c <= c2; ++c)
+			{
+			    nfa_add_start_byte(c, bytes, TRUE);
+			    if (c >= 0x100)
+				break;
+			}
+			p = p->out;
+		    }
+		    else if (p->c > 0)
+			nfa_add_start_byte(p->c, bytes, FALSE);
+		    else if (p->c >= NFA_CLASS_ALNUM && p->c <= NFA_CLASS_ESCAPE)
+		    {
+			for (c = 1; c < 0x100; ++c)
+			    if (check_char_class(p->c, c))
+				nfa_add_start_byte(c, bytes, TRUE);
+			nfa_add_start_byte(0x100, bytes, TRUE);
+		    }
+		    else
+			return FAIL;
+		}
+		return OK;
+
+	    default:
+		if (p->c > 0)
+		{
+		    nfa_add_start_byte(p->c, bytes, FALSE);
+		    return OK;
+		}
+		return FAIL;
+	}
+    }
+    return FAIL;
+}
+
+/*
+ * Figure out the bytes that every match starts with.  If that is a limited
+ * set return a bit array with a bit set for each of them in allocated memory.
+ * Otherwise return NULL.
+ */
+    static char_u *
+nfa_get_start_bytes(nfa_state_T *start)
+{
+    char_u	*bytes;
+    int		budget = 200;
+
+    bytes = alloc_clear(256 / 8);
+    if (bytes == NULL)
+	return NULL;
+    if (nfa_collect_start_bytes(start, bytes, &budget) == FAIL)
+	VIM_CLEAR(bytes);
+    return bytes;
+}
+
 /*
  * Allocate more space for post_start.  Called when
  * running above the estimated number of states.
@@ -7642,6 +7831,7 @@ nfa_regcomp(char_u *expr, int re_flags)
     prog->reganch = nfa_get_reganch(prog->start, 0);
     prog->regstart = nfa_get_regstart(prog->start, 0);
     prog->match_text = nfa_get_match_text(prog->start);
+    prog->start_bytes = nfa_get_start_bytes(prog->start);
 
 #ifdef ENABLE_LOG
     nfa_postfix_dump(expr, OK);
@@ -7683,6 +7873,7 @@ nfa_regfree(regprog_T *prog)
 	return;
 
     vim_free(((nfa_regprog_T *)prog)->match_text);
+    vim_free(((nfa_regprog_T *)prog)->start_bytes);
     vim_free(((nfa_regprog_T *)prog)->pattern);
     vim_free(prog);
 }
@@ -439,6 +439,161 @@ skip_for_popup(int row, int col)
     return FALSE;
 }
 
+/*
+ * Hashes of the rows of the window that is being redrawn completely, indexed
+ * by window row.  Used by screen_line() to find text that moved up on the
+ * screen, so that it can be scrolled instead of drawn again.
+ */
+static win_T	*rowhash_win = NULL;
+static long_u	*rowhash = NULL;
+static int	rowhash_prev_row;	// row drawn last, -1 if blank
+static long_u	rowhash_prev_hash;	// hash of "rowhash_prev_row"
+
+/*
+ * Compute the hash of "width" cells of ScreenLines[] starting at "off", where
+ * the cells from "len" onwards are taken to be blank.
+ * Sets "*blank" to TRUE when all cells are blank.
+ */
+    static long_u
+screen_cells_hash(unsigned off, int len, int width, int *blank)
+{
+    long_u	hash = 0;
+    int		i;
+
+    *blank = TRUE;
+    for (i = 0; i < width; ++i, ++off)
+    {
+	if (i >= len)
+	{
+	    hash = hash * 101 + ' ' * 31;
+	    continue;
+	}
+
+	long_u	c = ScreenLines[off];
+
+	// The UC value of the right half of a double-wide char is not used.
+	if (enc_utf8 && c != 0 && ScreenLinesUC[off] != 0)
+	    c = ScreenLinesUC[off] << 8;
+	if (c != ' ' || ScreenAttrs[off] != 0)
+	    *blank = FALSE;
+	hash = hash * 101 + c * 31 + ScreenAttrs[off];
+    }
+    return hash;
+}
+
+/*
+ * Compute the hashes of the rows of window "wp" from "row" to the end of the
+ * window.
+ */
+    static void
+rowhash_update(win_T *wp, int row)
+{
+    int		blank;
+
+    for ( ; row < wp->w_height; ++row)
+	rowhash[row] = screen_cells_hash(
+		    LineOffset[W_WINROW(wp) + row] + wp->w_wincol,
+					       wp->w_width, wp->w_width, &blank);
+}
+
+/*
+ * Called by win_update() before all the rows of window "wp" are drawn.
+ * Remembers the hashes of what is currently on the screen, so that text that
+ * only moved up can be scrolled by screen_line().
+ */
+    void
+win_rowhash_start(win_T *wp)
+{
+    // with only a few lines it's not worth the effort
+    if (wp->w_height < 5 || !screen_valid(FALSE))
+	return;
+    // Only with a scroll region the lines outside of the window, including
+    // the command line, are not affected.
+    if (!scroll_region || (wp->w_width != Columns && *T_CSV == NUL))
+	return;
+    // with the popup menu or a popup window visible scrolling doesn't work
+    if (pum_visible()
+#ifdef FEAT_PROP_POPUP
+	    || popup_visible || popup_is_popup(wp)
+#endif
+	    )
+	return;
+
+    rowhash = ALLOC_MULT(long_u, wp->w_height);
+    if (rowhash == NULL)
+	return;
+    rowhash_update(wp, 0);
+    rowhash_win = wp;
+    rowhash_prev_row = -1;
+}
+
+/*
+ * Called by win_update() when done drawing the rows of window "wp".
+ */
+    void
+win_rowhash_end(void)
+{
+    VIM_CLEAR(rowhash);
+    rowhash_win = NULL;
+}
+
+/*
+ * Called by screen_line() before drawing window row "row" of "rowhash_win".
+ * When the new contents of this row and the row above it are found together
+ * further down in the window, delete the lines in between, the following rows
+ * then most likely match without having to output them again.  Requiring two
+ * rows avoids scrolling for a short line that happens to appear elsewhere.
+ * All rows below "row" are going to be drawn, nothing is lost by deleting
+ * them.
+ */
+    static void
+screen_line_find_moved(
+	win_T	*wp,
+	int	row,
+	int	endcol,
+	int	clear_width)
+{
+    long_u	hash;
+    int		blank;
+    int		prev_ok;
+    int		i;
+
+    // Only when the rest of the line is cleared the new contents is known.
+    if (row < 0 || row >= wp->w_height || endcol > wp->w_width
+						  || clear_width != wp->w_width)
+    {
+	rowhash_prev_row = -1;
+	return;
+    }
+
+    hash = screen_cells_hash((unsigned)(current_ScreenLine - ScreenLines),
+					       endcol, clear_width, &blank);
+    prev_ok = rowhash_prev_row == row - 1;
+    rowhash_prev_row = blank ? -1 : row;
+    if (blank || !prev_ok || rowhash[row] == hash)
+    {
+	rowhash_prev_hash = hash;
+	return;
+    }
+
+    for (i = row + 1; i < wp->w_height; ++i)
+	if (rowhash[i] == hash && rowhash[i - 1] == rowhash_prev_hash)
+	{
+	    int save_clear_cmdline = clear_cmdline;
+
+	    if (win_del_lines(wp, row, i - row, FALSE, FALSE, 0) == OK)
+	    {
+		mch_memmove(rowhash + row, rowhash + i,
+				     (wp->w_height - i) * sizeof(long_u));
+		rowhash_update(wp, wp->w_height - (i - row));
+	    }
+	    // the command line was not scrolled, keep any message
+	    clear_cmdline = save_clear_cmdline;
+	    break;
+	}
+    rowhash_prev_hash = hash;
+}
+
 /*
  * Move one "cooked" screen line to the screen, but only the characters that
  * have actually changed.  Handle insert/delete character.
@@ -493,6 +648,9 @@ screen_line(
     if (endcol > Columns)
 	endcol = Columns;
 
+    if (wp == rowhash_win && (flags & (SLF_RIGHTLEFT | SLF_POPUP)) == 0)
+	screen_line_find_moved(wp, row - W_WINROW(wp), endcol, clear_width);
+
 # ifdef FEAT_CLIPBOARD
     clip_may_clear_selection(row, row);
 # endif
@@ -1113,10 +1271,16 @@ win_redr_custom(
     // Make a copy, because the statusline may include a function call that
     // might change the option value and free the memory.
     stl = vim_strsave(stl);
+    stl_uses_mode = FALSE;
     width = build_stl_str_hl(ewp, buf, sizeof(buf),
 				stl, opt_name, opt_scope,
 				fillchar, maxwidth, &hltab, &tabtab);
     vim_free(stl);
+    // Remember whether it needs to be redrawn when the mode changes.
+    if (wp == NULL)
+	tabline_uses_mode = stl_uses_mode;
+    else if (!draw_ruler)
+	wp->w_stl_uses_mode = stl_uses_mode;
     ewp->w_p_crb = p_crb_save;
 
     // Make all characters printable.
@@ -1903,6 +2067,137 @@ screen_stop_highlight(void)
     screen_attr = 0;
 }
 
+// Offset added to an RGB color by pen_color(), color numbers are below it.
+#define PEN_RGB 0x1000
+
+/*
+ * Return the color the terminal uses after screen_start_highlight() was used
+ * for "aep", NULL for no highlighting.  "what" is 'f' for the foreground, 'b'
+ * for the background and 'u' for the underline color.
+ * Returns zero for the default color of the terminal, "n + 1" for color
+ * number "n" and "rgb + PEN_RGB" for an RGB color.
+ */
+    static long
+pen_color(attrentry_T *aep, int what)
+{
+    int		n;
+#ifdef FEAT_TERMGUICOLORS
+    guicolor_T	rgb;
+
+    if (aep != NULL)
+    {
+	rgb = what == 'f' ? aep->ae_u.cterm.fg_rgb
+	    : what == 'b' ? aep->ae_u.cterm.bg_rgb : aep->ae_u.cterm.ul_rgb;
+	if (p_tgc && rgb != CTERMCOLOR)
+	{
+	    if (rgb != INVALCOLOR)
+		return rgb + PEN_RGB;
+	    aep = NULL;
+	}
+    }
+#endif
+    if (aep != NULL)
+    {
+	n = what == 'f' ? aep->ae_u.cterm.fg_color
+	    : what == 'b' ? aep->ae_u.cterm.bg_color : aep->ae_u.cterm.ul_color;
+	if (t_colors > 1 && n != 0)
+	    return n;
+    }
+
+    // Not set by the highlighting: screen_stop_highlight() has set the Normal
+    // color.
+#ifdef FEAT_TERMGUICOLORS
+    if (p_tgc)
+    {
+	rgb = what == 'f' ? cterm_normal_fg_gui_color
+	    : what == 'b' ? cterm_normal_bg_gui_color
+						  : cterm_normal_ul_gui_color;
+	return rgb == INVALCOLOR ? 0 : rgb + PEN_RGB;
+    }
+#endif
+    n = what == 'f' ? cterm_normal_fg_color
+	: what == 'b' ? cterm_normal_bg_color : cterm_normal_ul_color;
+    return t_colors > 1 ? n : 0;
+}
+
+/*
+ * Change the highlighting from "screen_attr" to "attr" by only sending the
+ * colors that differ, instead of resetting all attributes with
+ * screen_stop_highlight() and sending everything again with
+ * screen_start_highlight().  Only possible when "attr" uses the same
+ * attributes, such as bold, and no color goes back to the terminal default.
+ * Returns FAIL when the highlighting was not changed.
+ */
+    static int
+screen_change_highlight(int attr)
+{
+    attrentry_T *old_aep = NULL;
+    attrentry_T *new_aep = NULL;
+    long	old_color[3];
+    long	new_color[3];
+    int		i;
+
+    if (!full_screen || !IS_CTERM || p_wiv || cterm_normal_fg_bold
+	    || screen_attr < 0 || (screen_attr > 0 && screen_attr <= HL_ALL)
+	    || (attr > 0 && attr <= HL_ALL))
+	return FAIL;
+#ifdef MSWIN
+    if (!termcap_active)
+	return FAIL;
+#endif
+#ifdef FEAT_GUI
+    if (gui.in_use)
+	return FAIL;
+#endif
+#if defined(FEAT_VTP) && defined(FEAT_TERMGUICOLORS)
+    if (use_vtp())
+	return FAIL;
+#endif
+
+    if (screen_attr != 0
+		 && (old_aep = syn_cterm_attr2entry(screen_attr)) == NULL)
+	return FAIL;
+    if (attr != 0 && (new_aep = syn_cterm_attr2entry(attr)) == NULL)
+	return FAIL;
+    if ((old_aep == NULL ? 0 : old_aep->ae_attr)
+				      != (new_aep == NULL ? 0 : new_aep->ae_attr)
+	    || (old_aep != NULL && old_aep->ae_u.cterm.font != 0)
+	    || (new_aep != NULL && new_aep->ae_u.cterm.font != 0))
+	return FAIL;
+
+    for (i = 0; i < 3; ++i)
+    {
+	old_color[i] = pen_color(old_aep, "fbu"[i]);
+	new_color[i] = pen_color(new_aep, "fbu"[i]);
+	// A default color can only be restored with t_me.  The underline
+	// color may not be sent yet, see term_ul_rgb_color().
+	if (new_color[i] != old_color[i] && (new_color[i] == 0 || i == 2))
+	    return FAIL;
+    }
+
+    for (i = 0; i < 2; ++i)
+    {
+	if (new_color[i] == old_color[i])
+	    continue;
+#ifdef FEAT_TERMGUICOLORS
+	if (new_color[i] >= PEN_RGB)
+	{
+	    if (i == 0)
+		term_fg_rgb_color(new_color[i] - PEN_RGB);
+	    else
+		term_bg_rgb_color(new_color[i] - PEN_RGB);
+	    continue;
+	}
+#endif
+	if (i == 0)
+	    term_fg_color(new_color[i] - 1);
+	else
+	    term_bg_color(new_color[i] - 1);
+    }
+    screen_attr = attr;
+    return OK;
+}
+
 /*
  * Reset the colors for a cterm.  Used when leaving Vim.
  * The machine specific code may override this again.
@@ -1963,18 +2258,19 @@ screen_char(unsigned off, int row, int col)
     }
 
     /*
-     * Stop highlighting first, so it's easier to move the cursor.
+     * Stop highlighting first, so it's easier to move the cursor.  When only
+     * the colors change this is not needed.
      */
     if (screen_char_attr != 0)
 	attr = screen_char_attr;
     else
 	attr = ScreenAttrs[off];
-    if (screen_attr != attr)
+    if (screen_attr != attr && screen_change_highlight(attr) == FAIL)
 	screen_stop_highlight();
 
     windgoto(row, col);
 
-    if (screen_attr != attr)
+    if (screen_attr != attr && screen_change_highlight(attr) == FAIL)
 	screen_start_highlight(attr);
 
     if (enc_utf8 && ScreenLinesUC[off] != 0)
@@ -2236,7 +2532,8 @@ screen_fill(
 	    if (off < end_off)		// something to be cleared
 	    {
 		col = off - LineOffset[row];
-		screen_stop_highlight();
+		if (screen_attr != 0 && screen_change_highlight(0) == FAIL)
+		    screen_stop_highlight();
 		term_windgoto(row, col);// clear rest of this screen line
 		out_str(T_CE);
 		screen_start();		// don't know where cursor is now
@@ -3101,6 +3398,10 @@ windgoto(int row, int col)
 		 */
 		if (*--p == 0)
 		{
+		    // When highlighting is still on it has to be started
+		    // again after stopping it.
+		    if (attr != 0)
+			cost += HIGHL_COST * 2;
 		    cost += noinvcurs;
 		    while (i && *p++ == 0)
 			--i;
@@ -42,8 +42,12 @@ static void find_mps_values(int *initc, int *findc, int *backwards, int switchit
 static int is_zero_width(char_u *pattern, size_t patternlen, int move, pos_T *cur, int direction);
 static void cmdline_search_stat(int dirc, pos_T *pos, pos_T *cursor_pos, int show_top_bot_msg, char_u *msgbuf, size_t msgbuflen, int recompute, int maxcount, long timeout);
 static void update_search_stat(int dirc, pos_T *pos, pos_T *cursor_pos, searchstat_T *stat, int recompute, int maxcount, long timeout);
+static int search_count_usable(buf_T *buf, int maxcount, proftime_T *tm);
+static void search_count_lookup(searchcount_T *sc, pos_T *p, int maxcount, int *cur, int *cnt, int *exact_match, int *incomplete);
+static void search_count_store(buf_T *buf, garray_T *gap, int complete, int maxcount);
 static int fuzzy_match_compute_score(char_u *str, int strSz, int_u *matches, int numMatches);
 static int fuzzy_match_recursive(char_u *fuzpat, char_u *str, int_u strIdx, int *outScore, char_u *strBegin, int strLen, int_u *srcMatches, int_u *matches, int maxMatches, int nextMatch, int *recursionCount);
+static int fuzzy_match_possible(char_u *str, char_u *pat, int matchseq);
 #if defined(FEAT_EVAL) || defined(FEAT_PROTO)
 static int fuzzy_match_item_compare(const void *s1, const void *s2);
 static void fuzzy_match_in_list(list_T *l, char_u *str, int matchseq, char_u *key, callback_T *item_cb, int retmatchpos, list_T *fmatchlist, long max_matches);
@@ -545,6 +549,15 @@ last_search_pat(void)
     return spats[last_idx].pat;
 }
 
+/*
+ * Return the 'magic' value used for the last search pattern.
+ */
+    int
+last_search_pat_magic(void)
+{
+    return spats[last_idx].magic;
+}
+
 /*
  * Reset search direction to forward.  For "gd" and "gD" commands.
  */
@@ -695,6 +708,8 @@ searchit(
     int		unused_timeout_flag = FALSE;
     int		*timed_out = &unused_timeout_flag;  // set when timed out.
     int		search_from_match_end;		    // vi-compatible search?
+    char_u	*must_text;			    // text a match must contain
+    int		must_len;
 
     if (search_regcomp(pat, patlen, NULL, RE_SEARCH, pat_use,
 		   (options & (SEARCH_HIS + SEARCH_KEEP)), &regmatch) == FAIL)
@@ -795,6 +810,35 @@ searchit(
 		if (*timed_out)
 		    break;
 
+		// Skip over lines that do not contain the text that every
+		// match must contain.  This checks a whole memline block at a
+		// time, which is much faster than trying each line.
+		if (!at_first_line && (must_text = re_required_text(
+			   regmatch.regprog, regmatch.rmm_ic, &must_len)) != NULL)
+		{
+		    linenr_T	lnum_end;
+
+		    // Find the last line to check: the end of the buffer, the
+		    // stop line or, in the second loop, the start line.
+		    lnum_end = dir == FORWARD ? buf->b_ml.ml_line_count : 1;
+		    if (stop_lnum != 0 && (dir == FORWARD
+			       ? stop_lnum < lnum_end : stop_lnum > lnum_end))
+			lnum_end = stop_lnum;
+		    if (loop && (dir == FORWARD ? start_pos.lnum < lnum_end
+						 : start_pos.lnum > lnum_end))
+			lnum_end = start_pos.lnum;
+		    if (dir == FORWARD ? lnum_end >= lnum : lnum_end <= lnum)
+		    {
+			lnum = ml_find_text(buf, lnum, lnum_end, must_text,
+							 must_len, timed_out);
+			if (got_int || *timed_out)
+			    break;
+			// Continue in the last line when the text was not
+			// found, that takes care of stopping there.
+			if (lnum == 0)
+			    lnum = lnum_end;
+		    }
+		}
 		/*
 		 * Look for a match somewhere in line "lnum".
 		 */
@@ -1150,6 +1194,8 @@ searchit(
     while (--count > 0 && found);   // stop after count matches or no match
 
 #ifdef FEAT_RELTIME
+    if (extra_arg != NULL && *timed_out)
+	extra_arg->sa_timed_out_lnum = lnum;
     if (extra_arg != NULL && extra_arg->sa_tm > 0)
 	disable_regexp_timeout();
 #endif
@@ -3311,36 +3357,72 @@ update_search_stat(
 	int	done_search = FALSE;
 	pos_T	endpos = {0, 0, 0};
 
+	int	from_start = EMPTY_POS(lastpos);
+	garray_T matches;
+	searchmatch_T *sm;
+
 	p_ws = FALSE;
 #ifdef FEAT_RELTIME
 	if (timeout > 0)
 	    profile_setlimit(timeout, &start);
 #endif
-	while (!got_int && searchit(curwin, curbuf, &lastpos, &endpos,
-			 FORWARD, NULL, 0, 1, SEARCH_KEEP, RE_LAST, NULL) != FAIL)
-	{
-	    done_search = TRUE;
+	if (from_start && search_count_usable(curbuf, maxcount,
 #ifdef FEAT_RELTIME
-	    // Stop after passing the time limit.
-	    if (timeout > 0 && profile_passed_limit(&start))
-	    {
-		incomplete = 1;
-		break;
-	    }
+						timeout > 0 ? &start :
 #endif
-	    cnt++;
-	    if (LTOREQ_POS(lastpos, p))
-	    {
-		cur = cnt;
-		if (LT_POS(p, endpos))
-		    exact_match = TRUE;
-	    }
-	    fast_breakcheck();
-	    if (maxcount > 0 && cnt > maxcount)
+						NULL))
+	{
+	    // Counting from the start of the buffer: use the index.
+	    search_count_lookup(curbuf->b_search_count, &p, maxcount,
+					&cur, &cnt, &exact_match, &incomplete);
+	    done_search = cnt > 0;
+	}
+	else
+	{
+	    ga_init2(&matches, sizeof(searchmatch_T), 100);
+	    while (!got_int && searchit(curwin, curbuf, &lastpos, &endpos,
+			 FORWARD, NULL, 0, 1, SEARCH_KEEP, RE_LAST, NULL) != FAIL)
 	    {
-		incomplete = 2;    // max count exceeded
-		break;
+		done_search = TRUE;
+#ifdef FEAT_RELTIME
+		// Stop after passing the time limit.
+		if (timeout > 0 && profile_passed_limit(&start))
+		{
+		    incomplete = 1;
+		    break;
+		}
+#endif
+		cnt++;
+		if (LTOREQ_POS(lastpos, p))
+		{
+		    cur = cnt;
+		    if (LT_POS(p, endpos))
+			exact_match = TRUE;
+		}
+		if (from_start && ga_grow(&matches, 1) == OK)
+		{
+		    sm = (searchmatch_T *)matches.ga_data + matches.ga_len;
+		    sm->sm_start = lastpos;
+		    sm->sm_maxend = endpos;
+		    if (matches.ga_len > 0 && LT_POS(endpos, sm[-1].sm_maxend))
+			sm->sm_maxend = sm[-1].sm_maxend;
+		    ++matches.ga_len;
+		}
+		fast_breakcheck();
+		if (maxcount > 0 && cnt > maxcount)
+		{
+		    incomplete = 2;    // max count exceeded
+		    break;
+		}
 	    }
+	    // Remember the matches when all of them were found, or the first
+	    // "maxcount" + 1 of them.
+	    if (from_start && !got_int && incomplete != 1
+						   && matches.ga_len == cnt)
+		search_count_store(curbuf, &matches, incomplete == 0,
+								    maxcount);
+	    else
+		ga_clear(&matches);
 	}
 	if (got_int)
 	    cur = -1; // abort
@@ -3361,6 +3443,358 @@ update_search_stat(
     p_ws = save_ws;
 }
 
+/*
+ * Return TRUE when matches of the last search pattern only depend on the text
+ * of the line they are in.  Then a change to a line can only add or remove
+ * matches in that line.
+ */
+    static int
+search_pat_linelocal(void)
+{
+    regmmatch_T	regmatch;
+    int		linelocal;
+
+    if (search_regcomp((char_u *)"", 0, NULL, RE_SEARCH, RE_LAST,
+					       SEARCH_KEEP, &regmatch) == FAIL)
+	return FALSE;
+    linelocal = re_linelocal(spats[last_idx].pat, regmatch.regprog);
+    vim_regfree(regmatch.regprog);
+    return linelocal;
+}
+
+/*
+ * Free the search count index of buffer "buf".
+ */
+    void
+search_count_clear(buf_T *buf)
+{
+    searchcount_T *sc = buf->b_search_count;
+
+    if (sc == NULL)
+	return;
+    vim_free(sc->sci_pat);
+    vim_free(sc->sci_isk);
+    ga_clear(&sc->sci_ga);
+    VIM_CLEAR(buf->b_search_count);
+}
+
+/*
+ * Store the matches in "gap" as the search count index of "buf" for the last
+ * search pattern.  Takes over the allocated memory of "gap".
+ * "complete" is TRUE when all matches in the buffer were found.
+ */
+    static void
+search_count_store(buf_T *buf, garray_T *gap, int complete, int maxcount)
+{
+    searchcount_T *sc;
+
+    search_count_clear(buf);
+    // When matches depend on more than their own line, e.g. on the cursor
+    // position with "\%>.l", they can't be kept.
+    if (!search_pat_linelocal())
+    {
+	ga_clear(gap);
+	return;
+    }
+    sc = ALLOC_CLEAR_ONE(searchcount_T);
+    if (sc != NULL)
+    {
+	sc->sci_pat = vim_strsave(spats[last_idx].pat);
+	sc->sci_isk = vim_strsave(buf->b_p_isk);
+    }
+    if (sc == NULL || sc->sci_pat == NULL || sc->sci_isk == NULL)
+    {
+	if (sc != NULL)
+	{
+	    vim_free(sc->sci_pat);
+	    vim_free(sc->sci_isk);
+	}
+	vim_free(sc);
+	ga_clear(gap);
+	return;
+    }
+    sc->sci_magic = spats[last_idx].magic;
+    sc->sci_ic = p_ic;
+    sc->sci_scs = p_scs;
+    sc->sci_no_scs = spats[last_idx].no_scs;
+    sc->sci_re = p_re;
+    sc->sci_cpo_search = vim_strchr(p_cpo, CPO_SEARCH) != NULL;
+    sc->sci_changedtick = CHANGEDTICK(buf);
+    sc->sci_maxcount = maxcount;
+    sc->sci_complete = complete;
+    sc->sci_ga = *gap;
+    buf->b_search_count = sc;
+}
+
+/*
+ * Return the index of the first match in "sc" that starts in line "lnum" or
+ * later.
+ */
+    static int
+search_count_find_line(searchcount_T *sc, linenr_T lnum)
+{
+    searchmatch_T   *sm = (searchmatch_T *)sc->sci_ga.ga_data;
+    int		    lo = 0;
+    int		    hi = sc->sci_ga.ga_len;
+    int		    mid;
+
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	if (sm[mid].sm_start.lnum < lnum)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Recompute the "sm_maxend" of the matches in "sc", starting at index "idx".
+ */
+    static void
+search_count_fix_maxend(searchcount_T *sc, int idx)
+{
+    searchmatch_T   *sm = (searchmatch_T *)sc->sci_ga.ga_data;
+    int		    i;
+
+    for (i = idx; i < sc->sci_ga.ga_len; ++i)
+	if (i > 0 && LT_POS(sm[i].sm_maxend, sm[i - 1].sm_maxend))
+	    sm[i].sm_maxend = sm[i - 1].sm_maxend;
+}
+
+/*
+ * Called by changed_common() for a change in "buf" from line "lnum" until
+ * "lnume" (not including), with "xtra" lines added.  "old_tick" is
+ * b:changedtick from before the change.
+ * Removes the matches in the changed lines from the search count index and
+ * moves the ones below it.  The changed lines are searched again the next
+ * time the index is used.  When this isn't possible the index is dropped.
+ */
+    void
+search_count_changed(
+    buf_T	*buf,
+    linenr_T	lnum,
+    linenr_T	lnume,
+    long	xtra,
+    varnumber_T	old_tick)
+{
+    searchcount_T   *sc = buf->b_search_count;
+    searchmatch_T   *sm;
+    int		    first;
+    int		    last;
+    int		    i;
+
+    if (sc == NULL)
+	return;
+    if (!sc->sci_complete || sc->sci_changedtick != old_tick
+					  || CHANGEDTICK(buf) != old_tick + 1)
+    {
+	search_count_clear(buf);
+	return;
+    }
+
+    // Remove the matches in the changed lines and adjust the line number of
+    // the ones below them.
+    sm = (searchmatch_T *)sc->sci_ga.ga_data;
+    first = search_count_find_line(sc, lnum);
+    last = search_count_find_line(sc, lnume);
+    if (last > first)
+    {
+	mch_memmove(sm + first, sm + last,
+			  sizeof(searchmatch_T) * (sc->sci_ga.ga_len - last));
+	sc->sci_ga.ga_len -= last - first;
+    }
+    if (xtra != 0)
+	for (i = first; i < sc->sci_ga.ga_len; ++i)
+	{
+	    sm[i].sm_start.lnum += xtra;
+	    sm[i].sm_maxend.lnum += xtra;
+	}
+
+    // Extend the lines to be searched again, like b_mod_top and b_mod_bot.
+    if (sc->sci_dirty_bot != 0)
+    {
+	if (lnum < sc->sci_dirty_top)
+	    sc->sci_dirty_top = lnum;
+	if (lnum < sc->sci_dirty_bot)
+	{
+	    sc->sci_dirty_bot += xtra;
+	    if (sc->sci_dirty_bot < lnum)
+		sc->sci_dirty_bot = lnum;
+	}
+	if (lnume + xtra > sc->sci_dirty_bot)
+	    sc->sci_dirty_bot = lnume + xtra;
+    }
+    else
+    {
+	sc->sci_dirty_top = lnum;
+	sc->sci_dirty_bot = lnume + xtra;
+    }
+    sc->sci_changedtick = CHANGEDTICK(buf);
+}
+
+/*
+ * Search the lines of "buf" that changed since the search count index was
+ * built and add the matches to the index.
+ * Returns FAIL when interrupted or when "tm" is not NULL and the time limit
+ * passed.
+ */
+    static int
+search_count_update(buf_T *buf, proftime_T *tm UNUSED)
+{
+    searchcount_T   *sc = buf->b_search_count;
+    linenr_T	    top = sc->sci_dirty_top;
+    linenr_T	    bot = sc->sci_dirty_bot;
+    garray_T	    matches;
+    searchmatch_T   *sm;
+    pos_T	    pos;
+    pos_T	    endpos;
+    int		    options = SEARCH_KEEP + SEARCH_START;
+    searchit_arg_T  sia;
+    int		    idx;
+    int		    last;
+
+    if (bot > buf->b_ml.ml_line_count + 1)
+	bot = buf->b_ml.ml_line_count + 1;
+    CLEAR_FIELD(sia);
+    sia.sa_stop_lnum = bot - 1;
+    ga_init2(&matches, sizeof(searchmatch_T), 10);
+    pos.lnum = top;
+    pos.col = 0;
+    pos.coladd = 0;
+    while (top < bot && !got_int && searchit(curwin, buf, &pos, &endpos,
+			  FORWARD, NULL, 0, 1, options, RE_LAST, &sia) != FAIL)
+    {
+	options = SEARCH_KEEP;
+	if (pos.lnum < top || pos.lnum >= bot)
+	    break;
+#ifdef FEAT_RELTIME
+	if (tm != NULL && profile_passed_limit(tm))
+	{
+	    ga_clear(&matches);
+	    return FAIL;
+	}
+#endif
+	if (ga_grow(&matches, 1) == FAIL)
+	{
+	    ga_clear(&matches);
+	    return FAIL;
+	}
+	sm = (searchmatch_T *)matches.ga_data + matches.ga_len;
+	sm->sm_start = pos;
+	sm->sm_maxend = endpos;
+	++matches.ga_len;
+	fast_breakcheck();
+    }
+    if (got_int || (matches.ga_len > 0
+			 && ga_grow(&sc->sci_ga, matches.ga_len) == FAIL))
+    {
+	ga_clear(&matches);
+	return FAIL;
+    }
+
+    // Replace the matches in the searched lines, there may be unchanged
+    // lines in between changes.
+    idx = search_count_find_line(sc, top);
+    last = search_count_find_line(sc, bot);
+    sm = (searchmatch_T *)sc->sci_ga.ga_data;
+    if (last > idx)
+    {
+	mch_memmove(sm + idx, sm + last,
+			  sizeof(searchmatch_T) * (sc->sci_ga.ga_len - last));
+	sc->sci_ga.ga_len -= last - idx;
+    }
+    if (matches.ga_len > 0)
+    {
+	mch_memmove(sm + idx + matches.ga_len, sm + idx,
+			   sizeof(searchmatch_T) * (sc->sci_ga.ga_len - idx));
+	mch_memmove(sm + idx, matches.ga_data,
+				   sizeof(searchmatch_T) * matches.ga_len);
+	sc->sci_ga.ga_len += matches.ga_len;
+    }
+    ga_clear(&matches);
+    search_count_fix_maxend(sc, idx);
+    sc->sci_dirty_bot = 0;
+    return OK;
+}
+
+/*
+ * Return TRUE when the search count index of "buf" can be used for the last
+ * search pattern, counting up to "maxcount" matches.  Searches changed lines
+ * again when needed, "tm" is the time limit for that or NULL.
+ */
+    static int
+search_count_usable(buf_T *buf, int maxcount, proftime_T *tm)
+{
+    searchcount_T *sc = buf->b_search_count;
+
+    if (sc == NULL || spats[last_idx].pat == NULL)
+	return FALSE;
+    if (sc->sci_changedtick != CHANGEDTICK(buf)
+	    || STRCMP(sc->sci_pat, spats[last_idx].pat) != 0
+	    || sc->sci_magic != spats[last_idx].magic
+	    || sc->sci_ic != p_ic
+	    || sc->sci_scs != p_scs
+	    || sc->sci_no_scs != spats[last_idx].no_scs
+	    || sc->sci_re != p_re
+	    || sc->sci_cpo_search != (vim_strchr(p_cpo, CPO_SEARCH) != NULL)
+	    || STRCMP(sc->sci_isk, buf->b_p_isk) != 0
+	    || (!sc->sci_complete
+			    && (maxcount <= 0 || maxcount > sc->sci_maxcount)))
+	return FALSE;
+    if (sc->sci_dirty_bot != 0 && search_count_update(buf, tm) == FAIL)
+    {
+	search_count_clear(buf);
+	return FALSE;
+    }
+    return TRUE;
+}
+
+/*
+ * Get the search count for cursor position "p" from index "sc", with the
+ * same results as counting the matches with searchit().
+ */
+    static void
+search_count_lookup(
+    searchcount_T   *sc,
+    pos_T	    *p,
+    int		    maxcount,
+    int		    *cur,
+    int		    *cnt,
+    int		    *exact_match,
+    int		    *incomplete)
+{
+    searchmatch_T   *sm = (searchmatch_T *)sc->sci_ga.ga_data;
+    int		    len = sc->sci_ga.ga_len;
+    int		    lo = 0;
+    int		    hi;
+    int		    mid;
+
+    if (maxcount > 0 && len > maxcount)
+    {
+	// Counting stops after finding "maxcount" + 1 matches.
+	len = maxcount + 1;
+	*incomplete = 2;
+    }
+    else
+	*incomplete = 0;
+    *cnt = len;
+
+    // Find the number of matches that start at or before "p".
+    hi = len;
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	if (LTOREQ_POS(sm[mid].sm_start, *p))
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    *cur = lo;
+    *exact_match = lo > 0 && LT_POS(*p, sm[lo - 1].sm_maxend);
+}
+
 #if defined(FEAT_FIND_ID) || defined(PROTO)
 
 /*
@@ -4470,6 +4904,7 @@ fuzzy_match_recursive(
     int		recursiveMatch = FALSE;
     int_u	bestRecursiveMatches[MAX_FUZZY_MATCHES];
     int		bestRecursiveScore = 0;
+    int		bestRecursiveCount = 0;
     int		first_match;
     int		matched;
 
@@ -4489,19 +4924,28 @@ fuzzy_match_recursive(
 	int	c1;
 	int	c2;
 
-	c1 = PTR2CHAR(fuzpat);
-	c2 = PTR2CHAR(str);
+	// Quick check for ASCII, which is the most common.
+	if (*fuzpat < 0x80 && *str < 0x80 && (cmp_flags & CMP_KEEPASCII))
+	{
+	    c1 = TOLOWER_ASC(*fuzpat);
+	    c2 = TOLOWER_ASC(*str);
+	}
+	else
+	{
+	    c1 = vim_tolower(PTR2CHAR(fuzpat));
+	    c2 = vim_tolower(PTR2CHAR(str));
+	}
 
 	// Found match
-	if (vim_tolower(c1) == vim_tolower(c2))
+	if (c1 == c2)
 	{
 	    // Supplied matches buffer was too short
 	    if (nextMatch >= maxMatches)
 		return 0;
 
 	    int		recursiveScore = 0;
+	    int		recursiveCount;
 	    int_u	recursiveMatches[MAX_FUZZY_MATCHES];
-	    CLEAR_FIELD(recursiveMatches);
 
 	    // "Copy-on-Write" srcMatches into matches
 	    if (first_match && srcMatches)
@@ -4512,18 +4956,21 @@ fuzzy_match_recursive(
 
 	    // Recursive call that "skips" this match
 	    char_u *next_char = str + (has_mbyte ? (*mb_ptr2len)(str) : 1);
-	    if (fuzzy_match_recursive(fuzpat, next_char, strIdx + 1,
-			&recursiveScore, strBegin, strLen, matches,
+	    recursiveCount = fuzzy_match_recursive(fuzpat, next_char,
+			strIdx + 1, &recursiveScore, strBegin, strLen, matches,
 			recursiveMatches,
 			ARRAY_LENGTH(recursiveMatches),
-			nextMatch, recursionCount))
+			nextMatch, recursionCount);
+	    if (recursiveCount > 0)
 	    {
-		// Pick best recursive score
+		// Pick best recursive score.  Only the first "recursiveCount"
+		// entries are valid, don't copy the whole array.
 		if (!recursiveMatch || recursiveScore > bestRecursiveScore)
 		{
 		    memcpy(bestRecursiveMatches, recursiveMatches,
-			    MAX_FUZZY_MATCHES * sizeof(recursiveMatches[0]));
+				  recursiveCount * sizeof(recursiveMatches[0]));
 		    bestRecursiveScore = recursiveScore;
+		    bestRecursiveCount = recursiveCount;
 		}
 		recursiveMatch = TRUE;
 	    }
@@ -4554,7 +5001,8 @@ fuzzy_match_recursive(
     if (recursiveMatch && (!matched || bestRecursiveScore > *outScore))
     {
 	// Recursive score is better than "this"
-	memcpy(matches, bestRecursiveMatches, maxMatches * sizeof(matches[0]));
+	memcpy(matches, bestRecursiveMatches,
+				     bestRecursiveCount * sizeof(matches[0]));
 	*outScore = bestRecursiveScore;
 	return nextMatch;
     }
@@ -4564,6 +5012,61 @@ fuzzy_match_recursive(
     return 0;		// no match
 }
 
+/*
+ * Return FALSE when "str" cannot fuzzy match "pat": when the characters of a
+ * word in "pat", or of all of "pat" when "matchseq" is TRUE, do not appear in
+ * "str" in the same order, ignoring case.  This is a lot quicker than
+ * fuzzy_match_recursive(), which may go over "str" many times.
+ */
+    static int
+fuzzy_match_possible(char_u *str, char_u *pat, int matchseq)
+{
+    char_u	*p = pat;
+    char_u	*s;
+    int		c;
+
+    for (;;)
+    {
+	if (!matchseq)
+	    p = skipwhite(p);
+	if (*p == NUL)
+	    return TRUE;
+
+	s = str;
+	while (*p != NUL && (matchseq || !VIM_ISWHITE(PTR2CHAR(p))))
+	{
+	    c = vim_tolower(PTR2CHAR(p));
+	    if (c < 0x80 && (cmp_flags & CMP_KEEPASCII))
+	    {
+		// Quick check for ASCII, a non-ASCII character may still
+		// have an ASCII lower case.
+		while (*s != NUL)
+		{
+		    if (*s < 0x80)
+		    {
+			if (TOLOWER_ASC(*s) == c)
+			    break;
+			++s;
+		    }
+		    else
+		    {
+			if (vim_tolower(PTR2CHAR(s)) == c)
+			    break;
+			MB_PTR_ADV(s);
+		    }
+		}
+	    }
+	    else
+		while (*s != NUL && vim_tolower(PTR2CHAR(s)) != c)
+		    MB_PTR_ADV(s);
+	    if (*s == NUL)
+		return FALSE;
+	    MB_PTR_ADV(s);
+	    MB_PTR_ADV(p);
+	}
+    }
+}
+
 /*
  * fuzzy_match()
  *
@@ -4589,7 +5092,7 @@ fuzzy_match(
 	int		maxMatches)
 {
     int		recursionCount = 0;
-    int		len = MB_CHARLEN(str);
+    int		len;
     char_u	*save_pat;
     char_u	*pat;
     char_u	*p;
@@ -4600,6 +5103,11 @@ fuzzy_match(
 
     *outScore = 0;
 
+    if (!fuzzy_match_possible(str, pat_arg, matchseq))
+	return FALSE;
+
+    len = MB_CHARLEN(str);
+
     save_pat = vim_strsave(pat_arg);
     if (save_pat == NULL)
 	return FALSE;
@@ -203,6 +203,116 @@ sign_group_get_next_signid(buf_T *buf, char_u *groupname)
     return id;
 }
 
+/*
+ * Make "b_signindex" of buffer "buf" contain all the placed signs, in the
+ * order of "b_signlist".  Returns FAIL when out of memory.
+ */
+    static int
+sign_index_update(buf_T *buf)
+{
+    garray_T	    *gap = &buf->b_signindex;
+    sign_entry_T    *sign;
+
+    if (buf->b_signindex_valid)
+	return OK;
+
+    if (gap->ga_itemsize == 0)
+	ga_init2(gap, sizeof(sign_entry_T *), 100);
+    gap->ga_len = 0;
+    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    {
+	if (ga_grow(gap, 1) == FAIL)
+	{
+	    ga_clear(gap);
+	    return FAIL;
+	}
+	((sign_entry_T **)gap->ga_data)[gap->ga_len++] = sign;
+    }
+    buf->b_signindex_valid = TRUE;
+    return OK;
+}
+
+/*
+ * Return the index in "b_signindex" of buffer "buf" of the first sign on line
+ * "lnum" or below it.  Returns the number of signs when there is none.
+ * "b_signindex" must be valid.
+ */
+    static int
+sign_index_find(buf_T *buf, linenr_T lnum)
+{
+    sign_entry_T    **signs = (sign_entry_T **)buf->b_signindex.ga_data;
+    int		    lo = 0;
+    int		    hi = buf->b_signindex.ga_len;
+    int		    mid;
+
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	if (signs[mid]->se_lnum < lnum)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Return the first sign in buffer "buf" on line "lnum" or below it.  When out
+ * of memory this is the first sign in the buffer, thus callers must check the
+ * line number.  Returns NULL when there is none.
+ */
+    static sign_entry_T *
+buf_first_sign_from_line(buf_T *buf, linenr_T lnum)
+{
+    int		idx;
+
+    if (buf->b_signlist == NULL)
+	return NULL;
+    if (sign_index_update(buf) == FAIL)
+	return buf->b_signlist;
+    idx = sign_index_find(buf, lnum);
+    if (idx >= buf->b_signindex.ga_len)
+	return NULL;
+    return ((sign_entry_T **)buf->b_signindex.ga_data)[idx];
+}
+
+/*
+ * Add "sign", which was just inserted in the signlist of buffer "buf", to
+ * "b_signindex".
+ */
+    static void
+sign_index_insert(buf_T *buf, sign_entry_T *sign)
+{
+    garray_T	    *gap = &buf->b_signindex;
+    sign_entry_T    **signs;
+    int		    idx;
+
+    if (!buf->b_signindex_valid)
+	return;
+
+    // Find the position of the sign that follows, it is one of the signs on
+    // its line.
+    idx = gap->ga_len;
+    if (sign->se_next != NULL)
+    {
+	signs = (sign_entry_T **)gap->ga_data;
+	for (idx = sign_index_find(buf, sign->se_next->se_lnum);
+			 idx < gap->ga_len && signs[idx] != sign->se_next; ++idx)
+	    ;
+    }
+    if ((sign->se_next != NULL && idx == gap->ga_len)
+						    || ga_grow(gap, 1) == FAIL)
+    {
+	buf->b_signindex_valid = FALSE;
+	return;
+    }
+    signs = (sign_entry_T **)gap->ga_data;
+    mch_memmove(signs + idx + 1, signs + idx,
+			       (size_t)(gap->ga_len - idx) * sizeof(*signs));
+    signs[idx] = sign;
+    ++gap->ga_len;
+}
+
 /*
  * Insert a new sign into the signlist for buffer 'buf' between the 'prev' and
  * 'next' signs.
@@ -263,6 +373,7 @@ insert_sign(
     }
     else
 	prev->se_next = newsign;
+    sign_index_insert(buf, newsign);
 }
 
 /*
@@ -380,6 +491,7 @@ sign_sort_by_prio_on_line(buf_T *buf, sign_entry_T *sign)
     }
 
     // Remove 'sign' from the list
+    buf->b_signindex_valid = FALSE;
     if (buf->b_signlist == sign)
 	buf->b_signlist = sign->se_next;
     if (sign->se_prev != NULL)
@@ -427,8 +539,18 @@ buf_addsign(
     sign_entry_T	*sign;		// a sign in the signlist
     sign_entry_T	*prev;		// the previous sign
 
-    prev = NULL;
-    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    // Start at the signs on line "lnum", the ones before it can be skipped.
+    sign = buf_first_sign_from_line(buf, lnum);
+    if (sign != NULL)
+	prev = sign->se_prev;
+    else if (buf->b_signindex_valid && buf->b_signindex.ga_len > 0)
+	prev = ((sign_entry_T **)buf->b_signindex.ga_data)
+						 [buf->b_signindex.ga_len - 1];
+    else
+	for (prev = buf->b_signlist; prev != NULL && prev->se_next != NULL;
+							  prev = prev->se_next)
+	    ;
+    for ( ; sign != NULL; sign = sign->se_next)
     {
 	if (lnum == sign->se_lnum && id == sign->se_id
 		&& sign_in_group(sign, groupname))
@@ -494,7 +616,8 @@ buf_get_signattrs(win_T *wp, linenr_T lnum, sign_attrs_T *sattr)
 
     CLEAR_POINTER(sattr);
 
-    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    for (sign = buf_first_sign_from_line(buf, lnum); sign != NULL;
+							  sign = sign->se_next)
     {
 	if (sign->se_lnum > lnum)
 	    // Signs are sorted by line number in the buffer. No need to check
@@ -594,6 +717,7 @@ buf_delsign(
 	    *lastp = next;
 	    if (next != NULL)
 		next->se_prev = sign->se_prev;
+	    buf->b_signindex_valid = FALSE;
 	    lnum = sign->se_lnum;
 	    if (sign->se_group != NULL)
 		sign_group_unref(sign->se_group->sg_name);
@@ -657,7 +781,8 @@ buf_getsign_at_line(
 {
     sign_entry_T	*sign;		// a sign in the signlist
 
-    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    for (sign = buf_first_sign_from_line(buf, lnum); sign != NULL;
+							  sign = sign->se_next)
     {
 	if (sign->se_lnum > lnum)
 	    // Signs are sorted by line number in the buffer. No need to check
@@ -701,7 +826,8 @@ buf_findsigntype_id(
 {
     sign_entry_T	*sign;		// a sign in the signlist
 
-    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    for (sign = buf_first_sign_from_line(buf, lnum); sign != NULL;
+							  sign = sign->se_next)
     {
 	if (sign->se_lnum > lnum)
 	    // Signs are sorted by line number in the buffer. No need to check
@@ -726,7 +852,8 @@ buf_signcount(buf_T *buf, linenr_T lnum)
     sign_entry_T	*sign;		// a sign in the signlist
     int			count = 0;
 
-    FOR_ALL_SIGNS_IN_BUF(buf, sign)
+    for (sign = buf_first_sign_from_line(buf, lnum); sign != NULL;
+							  sign = sign->se_next)
     {
 	if (sign->se_lnum > lnum)
 	    // Signs are sorted by line number in the buffer. No need to check
@@ -778,6 +905,9 @@ buf_delete_signs(buf_T *buf, char_u *group)
 	else
 	    lastp = &sign->se_next;
     }
+    buf->b_signindex_valid = FALSE;
+    if (buf->b_signlist == NULL)
+	ga_clear(&buf->b_signindex);
 }
 
 /*
@@ -842,7 +972,8 @@ sign_mark_adjust(
     sign_entry_T	*sign;		// a sign in a b_signlist
     linenr_T		new_lnum;
 
-    FOR_ALL_SIGNS_IN_BUF(curbuf, sign)
+    for (sign = buf_first_sign_from_line(curbuf, line1); sign != NULL;
+							  sign = sign->se_next)
     {
 	// Ignore changes to lines after the sign
 	if (sign->se_lnum < line1)
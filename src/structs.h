@@ -535,7 +535,9 @@ struct block_hdr
 
 #define BH_DIRTY    1
 #define BH_LOCKED   2
-    char	bh_flags;	    // BH_DIRTY or BH_LOCKED
+#define BH_NOPROPS  4		    // memline: no line in the data block has
+				    // text properties, see ml_find_textprop()
+    char	bh_flags;	    // BH_DIRTY, BH_LOCKED or BH_NOPROPS
 };
 
 /*
@@ -1166,6 +1168,21 @@ struct syn_state
     linenr_T	sst_change_lnum;// when non-zero, change in this line
 				// may have made the state invalid
 };
+
+/*
+ * Syntax state stack taken out of a buffer while it is being reloaded, see
+ * syn_stack_save().
+ */
+typedef struct
+{
+    synstate_T	*ss_array;	// b_sst_array[] of the buffer
+    int		ss_len;		// b_sst_len of the buffer
+    synstate_T	*ss_first;	// b_sst_first of the buffer
+    synstate_T	*ss_firstfree;	// b_sst_firstfree of the buffer
+    int		ss_freecount;	// b_sst_freecount of the buffer
+    long_u	ss_hash;	// hash of the syntax items the states were
+				// computed with
+} synsave_T;
 #endif // FEAT_SYN_HL
 
 #define MAX_HL_ID       20000	// maximum value for a highlight ID.
@@ -2839,6 +2856,14 @@ typedef struct {
     long	count;		// nr of times used
     long	match;		// nr of times matched
 } syn_time_T;
+
+/*
+ * Used for ":syntime lines": time spent on matching patterns in a line.
+ */
+typedef struct {
+    proftime_T	total;		// total time used
+    linenr_T	lnum;		// line number
+} syn_line_time_T;
 #endif
 
 typedef struct timer_S timer_T;
@@ -2925,6 +2950,9 @@ typedef struct {
 #ifdef FEAT_SYN_HL
     hashtab_T	b_keywtab;		// syntax keywords hash table
     hashtab_T	b_keywtab_ic;		// idem, ignore case
+    char_u	b_keyw_filter[2][256];	// bits set for the first and last byte
+					// and length of the keywords in
+					// b_keywtab and b_keywtab_ic
     int		b_syn_error;		// TRUE when error occurred in HL
 # ifdef FEAT_RELTIME
     int		b_syn_slow;		// TRUE when 'redrawtime' reached
@@ -2947,6 +2975,10 @@ typedef struct {
     regprog_T	*b_syn_linecont_prog;	// line continuation program
 #ifdef FEAT_PROFILE
     syn_time_T  b_syn_linecont_time;
+    garray_T	b_syn_line_time;	// syn_line_time_T sorted on lnum
+    hashtab_T	b_syn_nest_time;	// time spent per nesting of groups
+    long	b_syn_sync_count;	// nr of times syncing was done
+    long	b_syn_stack_allocs;	// nr of times b_sst_array was allocated
 #endif
     int		b_syn_linecont_ic;	// ignore-case flag for above
     int		b_syn_topgrp;		// for ":syntax include"
@@ -2999,6 +3031,40 @@ typedef struct {
     char_u	*b_syn_isk;	    // iskeyword option
 } synblock_T;
 
+/*
+ * One match in the search count index.
+ */
+typedef struct
+{
+    pos_T	sm_start;	// start of the match
+    pos_T	sm_maxend;	// largest end of this and all previous matches
+} searchmatch_T;
+
+/*
+ * Index of the matches of the last search pattern in a buffer, used for the
+ * search count "[3/19]".  It is valid for one pattern and b:changedtick.  When
+ * the matches only depend on the text of their own line, changes to the
+ * buffer are patched in and only the changed lines are searched again.
+ */
+typedef struct
+{
+    char_u	*sci_pat;	// pattern the index was built for
+    int		sci_magic;	// 'magic' when the index was built
+    int		sci_ic;		// 'ignorecase' when the index was built
+    int		sci_scs;	// 'smartcase' when the index was built
+    int		sci_no_scs;	// no smartcase for the pattern
+    int		sci_re;		// 'regexpengine' when the index was built
+    int		sci_cpo_search;	// 'cpoptions' had "c" when the index was built
+    char_u	*sci_isk;	// 'iskeyword' when the index was built
+    varnumber_T	sci_changedtick; // b:changedtick the index is valid for
+    int		sci_maxcount;	// "maxcount" used when building
+    int		sci_complete;	// all matches in the buffer are in sci_ga
+    linenr_T	sci_dirty_top;	// first line that must be searched again
+    linenr_T	sci_dirty_bot;	// below last line that must be searched
+				// again, zero when nothing is dirty
+    garray_T	sci_ga;		// searchmatch_T items, in buffer order
+} searchcount_T;
+
 
 /*
  * buffer: structure that holds information about one file
@@ -3063,6 +3129,8 @@ struct file_buffer
     varnumber_T	b_last_changedtick_pum; // b:changedtick for TextChangedP
     varnumber_T	b_last_changedtick_i;   // b:changedtick for TextChangedI
 
+    searchcount_T *b_search_count;	// index for the search count or NULL
+
     int		b_saving;	// Set to TRUE if we are in the middle of
 				// saving the buffer.
 
@@ -3478,6 +3546,9 @@ struct file_buffer
 
 #ifdef FEAT_SIGNS
     sign_entry_T *b_signlist;	   // list of placed signs
+    garray_T	b_signindex;	   // signs of b_signlist in an array, for
+				   // finding the signs on a line quickly
+    int		b_signindex_valid; // b_signindex matches b_signlist
 # ifdef FEAT_NETBEANS_INTG
     int		b_has_sign_column; // Flag that is set when a first sign is
 				   // added and remains set until the end of
@@ -3619,6 +3690,52 @@ typedef struct w_line
 #endif
 } wline_T;
 
+/*
+ * Number of screen lines a buffer line takes, kept in plinescache_T.
+ */
+typedef struct
+{
+    linenr_T	pe_lnum;	// buffer line number
+    int		pe_lines;	// number of screen lines
+} plentry_T;
+
+/*
+ * Per-window cache of plines_win_nofold() results, so that scrolling does not
+ * require going over the text of long lines again.
+ */
+typedef struct
+{
+    buf_T	*pc_buf;	// buffer the cache is for
+    varnumber_T	pc_changedtick;	// b:changedtick the cache is valid for
+    int		pc_setting_tick; // "display_setting_tick" the cache is valid for
+    int		pc_width;	// width of the first screen line
+    int		pc_width2;	// width of further screen lines
+    garray_T	pc_ga;		// plentry_T items, sorted on line number
+} plinescache_T;
+
+/*
+ * Result of 'foldexpr' for a line, kept in fdecache_T.
+ */
+typedef struct
+{
+    int		fe_level;	// number returned by the expression
+    char	fe_type;	// character before the number, e.g. '>'
+    char	fe_valid;	// TRUE when the expression was evaluated
+} fdeentry_T;
+
+/*
+ * Per-window cache of 'foldexpr' results, so that updating the folds does not
+ * evaluate the expression more than once for a line.  Only valid for one
+ * b:changedtick.
+ */
+typedef struct
+{
+    buf_T	*fc_buf;	// buffer the cache is for
+    char_u	*fc_expr;	// copy of 'foldexpr' the cache is for
+    varnumber_T	fc_changedtick;	// b:changedtick the cache is valid for
+    garray_T	fc_ga;		// fdeentry_T items, index is lnum - 1
+} fdecache_T;
+
 /*
  * Windows are kept in a tree of frames.  Each frame has a column (FR_COL)
  * or row (FR_ROW) layout or is a leaf, which has a window.
@@ -3668,6 +3785,39 @@ typedef struct
 			    // CurSearch
 } match_T;
 
+/*
+ * Result of searching for a 'hlsearch' or match pattern in one line, kept in
+ * matchcache_T.
+ */
+typedef struct
+{
+    linenr_T	me_lnum;	// line where the search started
+    int		me_id;		// match ID, zero for 'hlsearch'
+    colnr_T	me_col;		// column where the search started
+    long	me_nmatched;	// result of vim_regexec_multi()
+    lpos_T	me_startpos;	// start of the match
+    lpos_T	me_endpos;	// end of the match
+} mcentry_T;
+
+/*
+ * Per-window cache of 'hlsearch' and match results, so that a redraw does not
+ * execute the patterns again for lines that did not change.  Only used for
+ * patterns whose matches only depend on the text of their own line.
+ */
+typedef struct
+{
+    buf_T	*mc_buf;	// buffer the cache is for
+    varnumber_T	mc_changedtick;	// b:changedtick the cache is valid for
+    char_u	*mc_hlpat;	// 'hlsearch' pattern the cache is for
+    int		mc_hlmagic;	// 'magic' used for mc_hlpat
+    int		mc_hlic;	// ignore case used for mc_hlpat
+    int		mc_hllinelocal;	// mc_hlpat can be cached
+    int		mc_re;		// 'regexpengine' used for the results
+    char_u	*mc_isk;	// 'iskeyword' used for the results
+    garray_T	mc_ga;		// mcentry_T items, sorted on line, ID and
+				// column
+} matchcache_T;
+
 /*
  * Same as lpos_T, but with additional field len.
  */
@@ -3686,6 +3836,7 @@ typedef struct matchitem matchitem_T;
 struct matchitem
 {
     matchitem_T	*mit_next;
+    matchitem_T	*mit_line_next;	// next match used in the line being drawn
     int		mit_id;		// match ID
     int		mit_priority;   // match priority
 
@@ -3693,10 +3844,13 @@ struct matchitem
     // positions is given (mit_pos is not NULL and mit_pos_count > 0).
     char_u	*mit_pattern;   // pattern to highlight
     regmmatch_T	mit_match;	// regexp program for pattern
+    int		mit_linelocal;	// results can be kept in w_match_cache
 
     llpos_T	*mit_pos_array;	// array of positions
+    llpos_T	**mit_pos_sorted; // mit_pos_array sorted on line and column
     int		mit_pos_count;	// nr of entries in mit_pos
-    int		mit_pos_cur;	// internal position counter
+    int		mit_pos_cur;	// internal position counter, index in
+				// mit_pos_sorted
     linenr_T	mit_toplnum;	// top buffer line
     linenr_T	mit_botlnum;	// bottom buffer line
 
@@ -4005,12 +4159,25 @@ struct window_S
     int		w_lines_valid;	    // number of valid entries
     wline_T	*w_lines;
 
+    plinescache_T w_plines_cache;   // cached plines_win_nofold() results
+#ifdef FEAT_PROFILE
+    long	w_drawtime_lines;   // nr of lines drawn since ":drawtime clear"
+#endif
+
 #ifdef FEAT_FOLDING
     garray_T	w_folds;	    // array of nested folds
     char	w_fold_manual;	    // when TRUE: some folds are opened/closed
 				    // manually
     char	w_foldinvalid;	    // when TRUE: folding needs to be
 				    // recomputed
+    fdecache_T	w_fdecache;	    // cached 'foldexpr' results
+    linenr_T	w_fold_paste_lnum;  // first line inserted while pasting for
+				    // which folds were not adjusted yet
+    long	w_fold_paste_count; // number of those lines
+    linenr_T	w_fold_paste_top;   // first line changed while pasting for
+				    // which folds were not updated yet, zero
+				    // if none
+    linenr_T	w_fold_paste_bot;   // last line of that range
 #endif
 #ifdef FEAT_LINEBREAK
     int		w_nrwidth;	    // width of 'number' and 'relativenumber'
@@ -4030,6 +4197,10 @@ struct window_S
     linenr_T	w_redraw_top;	    // when != 0: first line needing redraw
     linenr_T	w_redraw_bot;	    // when != 0: last line needing redraw
     int		w_redr_status;	    // if TRUE status line must be redrawn
+#ifdef FEAT_STL_OPT
+    char	w_stl_uses_mode;    // TRUE if 'statusline' used mode() when
+				    // it was last drawn
+#endif
 
     // remember what is shown in the ruler for this window (if 'ruler' set)
     pos_T	w_ru_cursor;	    // cursor position shown in ruler
@@ -4116,7 +4287,10 @@ struct window_S
 
 #ifdef FEAT_SEARCH_EXTRA
     matchitem_T	*w_match_head;		// head of match list
+    matchitem_T	*w_match_line_head;	// matches used in the line being
+					// drawn, linked with mit_line_next
     int		w_next_match_id;	// next match ID
+    matchcache_T w_match_cache;		// cached 'hlsearch' and match results
 #endif
 
     /*
@@ -4814,6 +4988,7 @@ typedef struct
 #ifdef FEAT_RELTIME
     long	sa_tm;		// timeout limit or zero
     int		sa_timed_out;	// set when timed out
+    linenr_T	sa_timed_out_lnum; // line being searched when timed out
 #endif
     int		sa_wrapped;	// search wrapped around
 } searchit_arg_T;
@@ -93,6 +93,13 @@ typedef struct syn_pattern
 
 #define MAXKEYWLEN	80	    // maximum length of a keyword
 
+// Bit in b_keyw_filter[] for a keyword with first byte "c1", last byte "c2"
+// and length "len".  Used to quickly skip words that are not a keyword.
+#define KEYW_FILTER_BIT(c1, c2, len) \
+		((((unsigned)(c1) * 131 + (c2)) * 131 + (unsigned)(len)) % 2048)
+#define KEYW_FILTER_SET(tab, bit)	((tab)[(bit) >> 3] |= 1 << ((bit) & 7))
+#define KEYW_FILTER_HAS(tab, bit)	((tab)[(bit) >> 3] & (1 << ((bit) & 7)))
+
 /*
  * The attributes of the syntax item that has been recognized.
  */
@@ -166,6 +173,21 @@ static keyentry_T dumkey;
 #define HIKEY2KE(p)   ((keyentry_T *)((p) - (dumkey.keyword - (char_u *)&dumkey)))
 #define HI2KE(hi)      HIKEY2KE((hi)->hi_key)
 
+#ifdef FEAT_PROFILE
+/*
+ * Time spent on matching patterns with a nesting of syntax groups, for
+ * ":syntime flame".  "hi_key" in b_syn_nest_time points to "nt_key".
+ */
+typedef struct
+{
+    proftime_T	nt_total;	// total time used
+    char_u	nt_key[1];	// group names separated by ';', actually longer
+} nesttime_T;
+
+# define HIKEY2NT(p) ((nesttime_T *)((p) - offsetof(nesttime_T, nt_key)))
+# define HI2NT(hi)   HIKEY2NT((hi)->hi_key)
+#endif
+
 /*
  * To reduce the time spent in keepend(), remember at which level in the state
  * stack the first item with "keepend" is present.  When "-1", there is no
@@ -276,6 +298,8 @@ static garray_T current_state		// current stack of state_items
 static short	*current_next_list = NULL; // when non-zero, nextgroup list
 static int	current_next_flags = 0; // flags for current_next_list
 static int	current_line_id = 0;	// unique number for current line
+static int	line_bytes_id = 0;	// current_line_id for line_bytes[]
+static char_u	line_bytes[32];		// bit set for each byte in the line
 
 #define CUR_STATE(idx)	((stateitem_T *)(current_state.ga_data))[idx]
 
@@ -294,6 +318,7 @@ static int syn_stack_equal(synstate_T *sp);
 static void validate_current_state(void);
 static int syn_finish_line(int syncing);
 static int syn_current_attr(int syncing, int displaying, int *can_spell, int keep_state);
+static int syn_may_match_line(synpat_T *spp);
 static int did_match_already(int idx, garray_T *gap);
 static stateitem_T *push_next_match(stateitem_T *cur_si);
 static void check_state_ends(void);
@@ -306,9 +331,15 @@ static int push_current_state(int idx);
 static void pop_current_state(void);
 #ifdef FEAT_PROFILE
 static void syn_clear_time(syn_time_T *tt);
+static void syntime_add(linenr_T lnum, int id, proftime_T *tm);
+static void syntime_apply_changes(synblock_T *block, buf_T *buf);
+static void syntime_clear_block(synblock_T *block);
 static void syntime_clear(void);
 static void syntime_report(void);
+static void syntime_lines(void);
+static void syntime_flame(void);
 static int syn_time_on = FALSE;
+static int syn_time_flame = FALSE;	// also time nesting of groups
 # define IF_SYN_TIME(p) (p)
 #else
 # define IF_SYN_TIME(p) NULL
@@ -323,7 +354,7 @@ static void limit_pos_zero(lpos_T *pos, lpos_T *limit);
 static void syn_add_end_off(lpos_T *result, regmmatch_T *regmatch, synpat_T *spp, int idx, int extra);
 static void syn_add_start_off(lpos_T *result, regmmatch_T *regmatch, synpat_T *spp, int idx, int extra);
 static char_u *syn_getcurline(void);
-static int syn_regexec(regmmatch_T *rmp, linenr_T lnum, colnr_T col, syn_time_T *st);
+static int syn_regexec(regmmatch_T *rmp, linenr_T lnum, colnr_T col, syn_time_T *st, int id);
 static int check_keyword_id(char_u *line, int startcol, int *endcol, long *flags, short **next_list, stateitem_T *cur_si, int *ccharp);
 static void syn_remove_pattern(synblock_T *block, int idx);
 static void syn_clear_pattern(synblock_T *block, int i);
@@ -529,6 +560,79 @@ syntax_start(win_T *wp, linenr_T lnum)
     syn_start_line();
 }
 
+/*
+ * Called while waiting for the user to type a key.  When the syntax of the
+ * current window is synchronized from the start of the file, compute the
+ * syntax states for the lines after the last stored one.  Jumping to the end
+ * of a long file then does not have to parse all the lines before it.
+ * Only does a small amount of work at a time.
+ * Returns TRUE when there is more to do.
+ */
+    int
+syntax_idle_parse(void)
+{
+    win_T	*wp = curwin;
+    synblock_T	*block = wp->w_s;
+    synstate_T	*p;
+    linenr_T	lnum = 0;
+    linenr_T	dist;
+#ifdef FEAT_RELTIME
+    proftime_T	tm;
+#endif
+
+    // Only when the screen is up to date, changes have been applied to the
+    // stored states then.
+    if ((State & (MODE_NORMAL | MODE_INSERT)) == 0
+	    || must_redraw != 0
+	    || updating_screen
+	    || wp->w_buffer->b_mod_set
+	    || block->b_syn_sync_minlines != MAXLNUM
+	    || block->b_sst_array == NULL
+	    || block->b_sst_len <= Rows
+	    || !syntax_present(wp))
+	return FALSE;
+
+    FOR_ALL_SYNSTATES(block, p)
+	lnum = p->sst_lnum;
+    // Use the same distance between states as syntax_start().
+    dist = wp->w_buffer->b_ml.ml_line_count / (block->b_sst_len - Rows) + 1;
+
+#ifdef FEAT_RELTIME
+    profile_setlimit(20L, &tm);
+#endif
+    while (lnum + dist <= wp->w_buffer->b_ml.ml_line_count)
+    {
+	lnum += dist;
+	syntax_start(wp, lnum);
+	if (got_int || !vim_is_input_buf_empty())
+	    break;
+#ifdef FEAT_RELTIME
+	if (profile_passed_limit(&tm))
+	    break;
+#else
+	break;
+#endif
+    }
+    return lnum + dist <= wp->w_buffer->b_ml.ml_line_count && !got_int;
+}
+
+#if defined(FEAT_EVAL) || defined(PROTO)
+/*
+ * Return the line number of the last stored syntax state of window "wp", zero
+ * when there is none.  Used by test_getvalue().
+ */
+    linenr_T
+syn_last_state_lnum(win_T *wp)
+{
+    synstate_T	*p;
+    linenr_T	lnum = 0;
+
+    FOR_ALL_SYNSTATES(wp->w_s, p)
+	lnum = p->sst_lnum;
+    return lnum;
+}
+#endif
+
 /*
  * We cannot simply discard growarrays full of state_items or buf_states; we
  * have to manually release their extmatch pointers first.
@@ -604,6 +708,10 @@ syn_sync(
      * Clear any current state that might be hanging around.
      */
     invalidate_current_state();
+#ifdef FEAT_PROFILE
+    if (syn_time_on)
+	++syn_block->b_syn_sync_count;
+#endif
 
     /*
      * Start at least "minlines" back.  Default starting point for parsing is
@@ -887,7 +995,7 @@ syn_match_linecont(linenr_T lnum)
     regmatch.rmm_ic = syn_block->b_syn_linecont_ic;
     regmatch.regprog = syn_block->b_syn_linecont_prog;
     r = syn_regexec(&regmatch, lnum, (colnr_T)0,
-	    IF_SYN_TIME(&syn_block->b_syn_linecont_time));
+	    IF_SYN_TIME(&syn_block->b_syn_linecont_time), 0);
     syn_block->b_syn_linecont_prog = regmatch.regprog;
     restore_chartab(buf_chartab);
     return r;
@@ -1060,6 +1168,189 @@ syn_stack_free_all(synblock_T *block)
 #endif
 }
 
+/*
+ * Remove the states from "block" that depend on line "lnum" or later.
+ * When "keep_next" is FALSE also remove states with a "nextgroup" list.
+ */
+    static void
+syn_stack_drop_from(synblock_T *block, linenr_T lnum, int keep_next)
+{
+    synstate_T	*p, *prev, *np;
+
+    prev = NULL;
+    for (p = block->b_sst_first; p != NULL; p = np)
+    {
+	np = p->sst_next;
+	if (p->sst_lnum + block->b_syn_sync_linebreaks > lnum
+		|| (!keep_next && p->sst_next_list != NULL))
+	{
+	    if (prev == NULL)
+		block->b_sst_first = np;
+	    else
+		prev->sst_next = np;
+	    syn_stack_free_entry(block, p);
+	}
+	else
+	    prev = p;
+    }
+}
+
+    static long_u
+syn_hash_id_list(long_u hash, short *list)
+{
+    if (list != NULL)
+	while (*list != 0)
+	    hash = hash * 101 + (long_u)*list++;
+    return hash * 101;
+}
+
+/*
+ * Compute a hash over everything in "block" that the stored syntax states
+ * depend on.  Used to check that the syntax items defined after reloading a
+ * buffer are the same as before.
+ */
+    static long_u
+syn_items_hash(synblock_T *block, buf_T *buf)
+{
+    long_u	hash = (long_u)buf->b_p_smc;
+    synpat_T	*spp;
+    hashtab_T	*ht;
+    hashitem_T	*hi;
+    keyentry_T	*kp;
+    long_u	kw_hash;
+    int		todo;
+    int		i;
+
+    for (i = 0; i < block->b_syn_patterns.ga_len; ++i)
+    {
+	spp = &(SYN_ITEMS(block)[i]);
+	hash = hash * 101 + (long_u)spp->sp_type;
+	hash = hash * 101 + (long_u)spp->sp_syncing;
+	hash = hash * 101 + (long_u)spp->sp_syn_match_id;
+	hash = hash * 101 + (long_u)spp->sp_off_flags;
+	hash = hash * 101 + (long_u)spp->sp_flags;
+	hash = hash * 101 + (long_u)spp->sp_ic;
+	hash = hash * 101 + (long_u)spp->sp_sync_idx;
+	hash = hash * 101 + (long_u)spp->sp_syn.inc_tag;
+	hash = hash * 101 + (long_u)spp->sp_syn.id;
+	hash = hash * 101 + (long_u)hash_hash(spp->sp_pattern);
+	hash = syn_hash_id_list(hash, spp->sp_cont_list);
+	hash = syn_hash_id_list(hash, spp->sp_next_list);
+	hash = syn_hash_id_list(hash, spp->sp_syn.cont_in_list);
+    }
+    for (i = 0; i < block->b_syn_clusters.ga_len; ++i)
+	hash = syn_hash_id_list(hash, SYN_CLSTR(block)[i].scl_list);
+
+    // A keyword match can stop a region from starting.  The order of the
+    // entries in the hashtable does not matter, thus add up the keywords.
+    ht = &block->b_keywtab;
+    for (;;)
+    {
+	kw_hash = ht->ht_used;
+	todo = (int)ht->ht_used;
+	FOR_ALL_HASHTAB_ITEMS(ht, hi, todo)
+	{
+	    if (!HASHITEM_EMPTY(hi))
+	    {
+		--todo;
+		for (kp = HI2KE(hi); kp != NULL; kp = kp->ke_next)
+		    kw_hash += hi->hi_hash * 101 + (long_u)kp->k_syn.id
+								 + kp->flags;
+	    }
+	}
+	hash = hash * 101 + kw_hash;
+	if (ht == &block->b_keywtab_ic)
+	    break;
+	ht = &block->b_keywtab_ic;
+    }
+
+    hash = hash * 101 + (long_u)block->b_syn_sync_flags;
+    hash = hash * 101 + (long_u)block->b_syn_sync_id;
+    hash = hash * 101 + (long_u)block->b_syn_sync_minlines;
+    hash = hash * 101 + (long_u)block->b_syn_sync_maxlines;
+    hash = hash * 101 + (long_u)block->b_syn_sync_linebreaks;
+    if (block->b_syn_linecont_pat != NULL)
+	hash = hash * 101 + (long_u)hash_hash(block->b_syn_linecont_pat);
+    if (block->b_syn_isk != empty_option)
+	hash = hash * 101 + (long_u)hash_hash(block->b_syn_isk);
+    return hash * 101 + (long_u)hash_hash(buf->b_p_isk);
+}
+
+/*
+ * Take the syntax states out of "buf" before it is reloaded.  The syntax
+ * items are usually cleared and defined again by the FileType autocommands,
+ * which would throw the states away.  syn_stack_restore() must be called
+ * afterwards.
+ */
+    void
+syn_stack_save(buf_T *buf, synsave_T *ssp)
+{
+    synblock_T	*block = &buf->b_s;
+
+    ssp->ss_array = block->b_sst_array;
+    if (ssp->ss_array == NULL)
+	return;
+    ssp->ss_len = block->b_sst_len;
+    ssp->ss_first = block->b_sst_first;
+    ssp->ss_firstfree = block->b_sst_firstfree;
+    ssp->ss_freecount = block->b_sst_freecount;
+    ssp->ss_hash = syn_items_hash(block, buf);
+
+    block->b_sst_array = NULL;
+    block->b_sst_first = NULL;
+    block->b_sst_firstfree = NULL;
+    block->b_sst_freecount = 0;
+    block->b_sst_len = 0;
+    if (syn_block == block)
+	invalidate_current_state();
+}
+
+/*
+ * Put back the syntax states saved with syn_stack_save() after "buf" was
+ * reloaded.  "lnum" is the first line whose text changed.  States computed
+ * before that line are still valid when the syntax items are the same as
+ * before, the others are dropped.
+ * When "buf" is NULL only free the saved states.
+ */
+    void
+syn_stack_restore(buf_T *buf, synsave_T *ssp, linenr_T lnum)
+{
+    synblock_T	*block;
+    synstate_T	*p;
+    tabpage_T	*tp;
+    win_T	*wp;
+
+    if (buf != NULL)
+    {
+	// Windows with their own syntax did not get their states cleared.
+	FOR_ALL_TAB_WINDOWS(tp, wp)
+	    if (wp->w_buffer == buf && wp->w_s != &buf->b_s)
+		syn_stack_drop_from(wp->w_s, lnum, TRUE);
+    }
+    if (ssp->ss_array == NULL)
+	return;
+
+    block = buf == NULL ? NULL : &buf->b_s;
+    if (block == NULL || lnum <= 1 || block->b_sst_array != NULL
+				 || syn_items_hash(block, buf) != ssp->ss_hash)
+    {
+	for (p = ssp->ss_first; p != NULL; p = p->sst_next)
+	    clear_syn_state(p);
+	VIM_CLEAR(ssp->ss_array);
+	return;
+    }
+
+    block->b_sst_array = ssp->ss_array;
+    block->b_sst_len = ssp->ss_len;
+    block->b_sst_first = ssp->ss_first;
+    block->b_sst_firstfree = ssp->ss_firstfree;
+    block->b_sst_freecount = ssp->ss_freecount;
+    ssp->ss_array = NULL;
+    syn_stack_drop_from(block, lnum, FALSE);
+    if (syn_block == block)
+	invalidate_current_state();
+}
+
 /*
  * Allocate the syntax state stack for syn_buf when needed.
  * If the number of entries in b_sst_array[] is much too big or a bit too
@@ -1102,6 +1393,10 @@ syn_stack_alloc(void)
 	sstp = ALLOC_CLEAR_MULT(synstate_T, len);
 	if (sstp == NULL)	// out of memory!
 	    return;
+#ifdef FEAT_PROFILE
+	if (syn_time_on)
+	    ++syn_block->b_syn_stack_allocs;
+#endif
 
 	to = sstp - 1;
 	if (syn_block->b_sst_array != NULL)
@@ -1202,8 +1497,38 @@ syn_stack_apply_changes_block(synblock_T *block, buf_T *buf)
 	prev = p;
 	p = p->sst_next;
     }
+#ifdef FEAT_PROFILE
+    syntime_apply_changes(block, buf);
+#endif
 }
 
+#ifdef FEAT_PROFILE
+/*
+ * Adjust the line numbers of the ":syntime lines" times of "block" for
+ * changes in "buf".  Lines that were deleted are dropped.
+ */
+    static void
+syntime_apply_changes(synblock_T *block, buf_T *buf)
+{
+    garray_T	    *gap = &block->b_syn_line_time;
+    syn_line_time_T *lt = (syn_line_time_T *)gap->ga_data;
+    linenr_T	    old_bot = buf->b_mod_bot - buf->b_mod_xlines;
+    int		    from;
+    int		    to = 0;
+
+    for (from = 0; from < gap->ga_len; ++from)
+    {
+	if (lt[from].lnum >= old_bot)
+	    lt[from].lnum += buf->b_mod_xlines;
+	else if (lt[from].lnum >= buf->b_mod_top
+					   && lt[from].lnum >= buf->b_mod_bot)
+	    continue;  // in the changed lines and deleted
+	lt[to++] = lt[from];
+    }
+    gap->ga_len = to;
+}
+#endif
+
 /*
  * Reduce the number of entries in the state stack for syn_buf.
  * Returns TRUE if at least one entry was freed.
@@ -1956,6 +2281,18 @@ syn_current_attr(
 				continue;
 			    spp->sp_line_id = current_line_id;
 
+			    // Quickly skip patterns that cannot match in this
+			    // line, without invoking the regexp engine.
+			    if (!syn_may_match_line(spp))
+			    {
+#ifdef FEAT_PROFILE
+				if (syn_time_on)
+				    ++spp->sp_time.count;
+#endif
+				spp->sp_startcol = MAXCOL;
+				continue;
+			    }
+
 			    lc_col = current_col - spp->sp_offsets[SPO_LC_OFF];
 			    if (lc_col < 0)
 				lc_col = 0;
@@ -1965,7 +2302,8 @@ syn_current_attr(
 			    r = syn_regexec(&regmatch,
 					     current_lnum,
 					     (colnr_T)lc_col,
-					     IF_SYN_TIME(&spp->sp_time));
+					     IF_SYN_TIME(&spp->sp_time),
+					     spp->sp_syn.id);
 			    spp->sp_prog = regmatch.regprog;
 			    if (!r)
 			    {
@@ -2316,6 +2654,46 @@ syn_current_attr(
     return current_attr;
 }
 
+/*
+ * Return FALSE when pattern "spp" cannot match in the current line, because
+ * the line does not contain any byte that a match can start with, or not all
+ * bytes of the text every match contains.  The bytes in the line are collected
+ * once per line, this is much cheaper than a call to the regexp engine.
+ */
+    static int
+syn_may_match_line(synpat_T *spp)
+{
+    char_u	*p;
+    char_u	*bytes;
+    char_u	*text;
+    int		len;
+    int		i;
+
+    if (line_bytes_id != current_line_id)
+    {
+	CLEAR_FIELD(line_bytes);
+	for (p = syn_getcurline(); *p != NUL; ++p)
+	    line_bytes[*p >> 3] |= 1 << (*p & 7);
+	line_bytes_id = current_line_id;
+    }
+
+    bytes = re_start_bytes(spp->sp_prog, spp->sp_ic);
+    if (bytes != NULL)
+    {
+	for (i = 0; i < (int)sizeof(line_bytes); ++i)
+	    if (bytes[i] & line_bytes[i])
+		break;
+	if (i == (int)sizeof(line_bytes))
+	    return FALSE;
+    }
+
+    text = re_required_text(spp->sp_prog, spp->sp_ic, &len);
+    if (text != NULL)
+	for (i = 0; i < len; ++i)
+	    if (!(line_bytes[text[i] >> 3] & (1 << (text[i] & 7))))
+		return FALSE;
+    return TRUE;
+}
 
 /*
  * Check if we already matched pattern "idx" at the current column.
@@ -2848,7 +3226,7 @@ find_endpos(
 	    regmatch.rmm_ic = spp->sp_ic;
 	    regmatch.regprog = spp->sp_prog;
 	    r = syn_regexec(&regmatch, startpos->lnum, lc_col,
-						  IF_SYN_TIME(&spp->sp_time));
+				   IF_SYN_TIME(&spp->sp_time), spp->sp_syn.id);
 	    spp->sp_prog = regmatch.regprog;
 	    if (r)
 	    {
@@ -2883,7 +3261,7 @@ find_endpos(
 	    regmatch.rmm_ic = spp_skip->sp_ic;
 	    regmatch.regprog = spp_skip->sp_prog;
 	    r = syn_regexec(&regmatch, startpos->lnum, lc_col,
-					      IF_SYN_TIME(&spp_skip->sp_time));
+			 IF_SYN_TIME(&spp_skip->sp_time), spp_skip->sp_syn.id);
 	    spp_skip->sp_prog = regmatch.regprog;
 	    if (r && regmatch.startpos[0].col
 					     <= best_regmatch.startpos[0].col)
@@ -3131,6 +3509,8 @@ syn_getcurline(void)
 
 /*
  * Call vim_regexec() to find a match with "rmp" in "syn_buf".
+ * "id" is the syntax group of the pattern, zero for the line continuation
+ * pattern.
  * Returns TRUE when there is a match.
  */
     static int
@@ -3138,7 +3518,8 @@ syn_regexec(
     regmmatch_T	*rmp,
     linenr_T	lnum,
     colnr_T	col,
-    syn_time_T  *st UNUSED)
+    syn_time_T  *st UNUSED,
+    int		id UNUSED)
 {
     int		r;
     int		timed_out = FALSE;
@@ -3168,6 +3549,7 @@ syn_regexec(
 	++st->count;
 	if (r > 0)
 	    ++st->match;
+	syntime_add(lnum, id, &pt);
     }
 #endif
 #ifdef FEAT_RELTIME
@@ -3206,6 +3588,10 @@ check_keyword_id(
     char_u	*kwp;
     int		round;
     int		kwlen;
+    int		has_multibyte = FALSE;
+    int		ascii_fold = enc_utf8 && (cmp_flags & CMP_KEEPASCII);
+    int		len;
+    int		bit;
     char_u	keyword[MAXKEYWLEN + 1]; // assume max. keyword len is 80
     hashtab_T	*ht;
     hashitem_T	*hi;
@@ -3217,7 +3603,12 @@ check_keyword_id(
     do
     {
 	if (has_mbyte)
-	    kwlen += (*mb_ptr2len)(kwp + kwlen);
+	{
+	    len = (*mb_ptr2len)(kwp + kwlen);
+	    if (len > 1)
+		has_multibyte = TRUE;
+	    kwlen += len;
+	}
 	else
 	    ++kwlen;
     }
@@ -3226,12 +3617,6 @@ check_keyword_id(
     if (kwlen > MAXKEYWLEN)
 	return 0;
 
-    /*
-     * Must make a copy of the keyword, so we can add a NUL and make it
-     * lowercase.
-     */
-    vim_strncpy(keyword, kwp, kwlen);
-
     /*
      * Try twice:
      * 1. matching case
@@ -3242,7 +3627,31 @@ check_keyword_id(
 	ht = round == 1 ? &syn_block->b_keywtab : &syn_block->b_keywtab_ic;
 	if (ht->ht_used == 0)
 	    continue;
-	if (round == 2)	// ignore case
+
+	// Most words are not a keyword, skip them without making a copy and
+	// computing the hash when no keyword has the same first and last byte
+	// and length.  When ignoring case with a multibyte encoding this only
+	// works for ASCII with 'casemap' containing "keepascii", other
+	// characters may fold to a character with different bytes.
+	if (round == 1)
+	    bit = KEYW_FILTER_BIT(kwp[0], kwp[kwlen - 1], kwlen);
+	else if (!has_mbyte)
+	    bit = KEYW_FILTER_BIT(TOLOWER_LOC(kwp[0]),
+					 TOLOWER_LOC(kwp[kwlen - 1]), kwlen);
+	else if (ascii_fold && !has_multibyte)
+	    bit = KEYW_FILTER_BIT(TOLOWER_ASC(kwp[0]),
+					 TOLOWER_ASC(kwp[kwlen - 1]), kwlen);
+	else
+	    bit = -1;
+	if (bit >= 0
+		&& !KEYW_FILTER_HAS(syn_block->b_keyw_filter[round - 1], bit))
+	    continue;
+
+	// Must make a copy of the keyword, so we can add a NUL and make it
+	// lowercase.
+	if (round == 1)
+	    vim_strncpy(keyword, kwp, kwlen);
+	else
 	    (void)str_foldcase(kwp, kwlen, keyword, MAXKEYWLEN + 1);
 
 	/*
@@ -3491,6 +3900,7 @@ syntax_clear(synblock_T *block)
     // free the keywords
     clear_keywtab(&block->b_keywtab);
     clear_keywtab(&block->b_keywtab_ic);
+    CLEAR_FIELD(block->b_keyw_filter);
 
     // free the syntax patterns
     for (i = block->b_syn_patterns.ga_len; --i >= 0; )
@@ -3520,6 +3930,9 @@ syntax_clear(synblock_T *block)
     // free the stored states
     syn_stack_free_all(block);
     invalidate_current_state();
+#ifdef FEAT_PROFILE
+    syntime_clear_block(block);
+#endif
 
     // Reset the counter for ":syn include"
     running_syn_inc_tag = 0;
@@ -4405,6 +4818,8 @@ add_keyword(
     char_u	*name_ic;
     long_u	hash;
     char_u	name_folded[MAXKEYWLEN + 1];
+    int		idx;
+    int		len;
 
     if (curwin->w_s->b_syn_ic)
 	name_ic = str_foldcase(name, (int)STRLEN(name),
@@ -4425,9 +4840,20 @@ add_keyword(
     kp->next_list = copy_id_list(next_list);
 
     if (curwin->w_s->b_syn_ic)
+    {
 	ht = &curwin->w_s->b_keywtab_ic;
+	idx = 1;
+    }
     else
+    {
 	ht = &curwin->w_s->b_keywtab;
+	idx = 0;
+    }
+
+    len = (int)STRLEN(kp->keyword);
+    if (len > 0)
+	KEYW_FILTER_SET(curwin->w_s->b_keyw_filter[idx], KEYW_FILTER_BIT(
+			       kp->keyword[0], kp->keyword[len - 1], len));
 
     hash = hash_hash(kp->keyword);
     hi = hash_lookup(ht, kp->keyword, hash);
@@ -6288,6 +6714,11 @@ ex_ownsyntax(exarg_T *eap)
 	CLEAR_POINTER(curwin->w_s);
 	hash_init(&curwin->w_s->b_keywtab);
 	hash_init(&curwin->w_s->b_keywtab_ic);
+#ifdef FEAT_PROFILE
+	hash_init(&curwin->w_s->b_syn_nest_time);
+	ga_init2(&curwin->w_s->b_syn_line_time,
+						   sizeof(syn_line_time_T), 100);
+#endif
 #ifdef FEAT_SPELL
 	// TODO: keep the spell checking as it was.
 	curwin->w_p_spell = FALSE;	// No spell checking
@@ -6606,14 +7037,24 @@ syn_get_foldlevel(win_T *wp, long lnum)
     void
 ex_syntime(exarg_T *eap)
 {
-    if (STRCMP(eap->arg, "on") == 0)
+    if (STRCMP(eap->arg, "on") == 0 || STRCMP(eap->arg, "on flame") == 0)
+    {
 	syn_time_on = TRUE;
+	syn_time_flame = eap->arg[2] != NUL;
+    }
     else if (STRCMP(eap->arg, "off") == 0)
+    {
 	syn_time_on = FALSE;
+	syn_time_flame = FALSE;
+    }
     else if (STRCMP(eap->arg, "clear") == 0)
 	syntime_clear();
     else if (STRCMP(eap->arg, "report") == 0)
 	syntime_report();
+    else if (STRCMP(eap->arg, "lines") == 0)
+	syntime_lines();
+    else if (STRCMP(eap->arg, "flame") == 0)
+	syntime_flame();
     else
 	semsg(_(e_invalid_argument_str), eap->arg);
 }
@@ -6627,6 +7068,124 @@ syn_clear_time(syn_time_T *st)
     st->match = 0;
 }
 
+/*
+ * Add time "tm" to the time spent in line "lnum".  Only lines on which
+ * patterns were matched have an entry, sorted on the line number.
+ */
+    static void
+syntime_add_line(linenr_T lnum, proftime_T *tm)
+{
+    garray_T	    *gap = &syn_block->b_syn_line_time;
+    syn_line_time_T *lt = (syn_line_time_T *)gap->ga_data;
+    int		    lo = 0;
+    int		    hi = gap->ga_len;
+    int		    mid;
+
+    // Lines are mostly parsed from the top down, try after the last entry
+    // before doing a binary search.
+    if (gap->ga_len > 0 && lt[gap->ga_len - 1].lnum < lnum)
+	lo = gap->ga_len;
+    else
+	while (lo < hi)
+	{
+	    mid = (lo + hi) / 2;
+	    if (lt[mid].lnum < lnum)
+		lo = mid + 1;
+	    else
+		hi = mid;
+	}
+
+    if (lo == gap->ga_len || lt[lo].lnum != lnum)
+    {
+	if (ga_grow(gap, 1) == FAIL)
+	    return;
+	lt = (syn_line_time_T *)gap->ga_data;
+	if (lo < gap->ga_len)
+	    mch_memmove(lt + lo + 1, lt + lo,
+			 sizeof(syn_line_time_T) * (size_t)(gap->ga_len - lo));
+	++gap->ga_len;
+	profile_zero(&lt[lo].total);
+	lt[lo].lnum = lnum;
+    }
+    profile_add(&lt[lo].total, tm);
+}
+
+/*
+ * Add time "tm", spent on matching a pattern of syntax group "id" in line
+ * "lnum", to the time of that line and, when "id" is not zero and
+ * ":syntime on flame" was used, to the time of the current nesting of syntax
+ * groups.
+ */
+    static void
+syntime_add(linenr_T lnum, int id, proftime_T *tm)
+{
+    hashtab_T	*ht = &syn_block->b_syn_nest_time;
+    garray_T	ga;
+    hashitem_T	*hi;
+    hash_T	hash;
+    nesttime_T	*ntp;
+    int		i;
+
+    syntime_add_line(lnum, tm);
+
+    // Building the nesting is relatively slow, only do it when needed.
+    if (!syn_time_flame || id <= 0)
+	return;
+    ga_init2(&ga, 1, 100);
+    for (i = 0; i < current_state.ga_len; ++i)
+	if (CUR_STATE(i).si_id > 0)
+	{
+	    ga_concat(&ga, highlight_group_name(CUR_STATE(i).si_id - 1));
+	    ga_append(&ga, ';');
+	}
+    ga_concat(&ga, highlight_group_name(id - 1));
+    ga_append(&ga, NUL);
+    if (ga.ga_data == NULL)
+	return;
+
+    hash = hash_hash(ga.ga_data);
+    hi = hash_lookup(ht, ga.ga_data, hash);
+    if (!HASHITEM_EMPTY(hi))
+	ntp = HI2NT(hi);
+    else
+    {
+	ntp = alloc(offsetof(nesttime_T, nt_key) + ga.ga_len);
+	if (ntp != NULL)
+	{
+	    profile_zero(&ntp->nt_total);
+	    STRCPY(ntp->nt_key, ga.ga_data);
+	    if (hash_add_item(ht, hi, ntp->nt_key, hash) == FAIL)
+		VIM_CLEAR(ntp);
+	}
+    }
+    if (ntp != NULL)
+	profile_add(&ntp->nt_total, tm);
+    ga_clear(&ga);
+}
+
+/*
+ * Clear the per line and per nesting syntax timing of "block".
+ */
+    static void
+syntime_clear_block(synblock_T *block)
+{
+    hashitem_T	*hi;
+    int		todo;
+
+    ga_clear(&block->b_syn_line_time);
+    todo = (int)block->b_syn_nest_time.ht_used;
+    FOR_ALL_HASHTAB_ITEMS(&block->b_syn_nest_time, hi, todo)
+	if (!HASHITEM_EMPTY(hi))
+	{
+	    --todo;
+	    vim_free(HI2NT(hi));
+	}
+    hash_clear(&block->b_syn_nest_time);
+    hash_init(&block->b_syn_nest_time);
+    block->b_syn_sync_count = 0;
+    block->b_syn_stack_allocs = 0;
+}
+
 /*
  * Clear the syntax timing for the current buffer.
  */
@@ -6646,11 +7205,12 @@ syntime_clear(void)
 	spp = &(SYN_ITEMS(curwin->w_s)[idx]);
 	syn_clear_time(&spp->sp_time);
     }
+    syntime_clear_block(curwin->w_s);
 }
 
 /*
  * Function given to ExpandGeneric() to obtain the possible arguments of the
- * ":syntime {on,off,clear,report}" command.
+ * ":syntime {on,off,clear,report,lines,flame}" command.
  */
     char_u *
 get_syntime_arg(expand_T *xp UNUSED, int idx)
@@ -6661,6 +7221,8 @@ get_syntime_arg(expand_T *xp UNUSED, int idx)
 	case 1: return (char_u *)"off";
 	case 2: return (char_u *)"clear";
 	case 3: return (char_u *)"report";
+	case 4: return (char_u *)"lines";
+	case 5: return (char_u *)"flame";
     }
     return NULL;
 }
@@ -6783,6 +7345,136 @@ syntime_report(void)
 	msg_puts("\n");
     }
 }
+
+// Maximum number of lines listed by ":syntime lines".
+#define SYNTIME_MAX_LINES 20
+
+    static int
+syn_compare_linetime(const void *v1, const void *v2)
+{
+    const syn_line_time_T	*s1 = v1;
+    const syn_line_time_T	*s2 = v2;
+
+    return profile_cmp(&s1->total, &s2->total);
+}
+
+/*
+ * ":syntime lines": list the lines on which most time was spent matching
+ * syntax patterns, and how often syncing was done and the state stack was
+ * allocated.
+ */
+    static void
+syntime_lines(void)
+{
+    garray_T	    *gap = &curwin->w_s->b_syn_line_time;
+    garray_T	    ga;
+    syn_line_time_T *p;
+    int		    idx;
+    int		    len;
+    char_u	    *line;
+
+    if (!syntax_present(curwin))
+    {
+	msg(_(msg_no_items));
+	return;
+    }
+
+    // Sort a copy, the stored times are sorted on line number.
+    ga_init2(&ga, sizeof(syn_line_time_T), 100);
+    if (gap->ga_len > 0 && ga_grow(&ga, gap->ga_len) == OK)
+    {
+	mch_memmove(ga.ga_data, gap->ga_data,
+			       sizeof(syn_line_time_T) * (size_t)gap->ga_len);
+	ga.ga_len = gap->ga_len;
+    }
+    if (ga.ga_len > 1)
+	qsort(ga.ga_data, (size_t)ga.ga_len, sizeof(syn_line_time_T),
+							 syn_compare_linetime);
+
+    msg_puts_title(_("  TOTAL      LINE   TEXT"));
+    msg_puts("\n");
+    for (idx = 0; idx < ga.ga_len && idx < SYNTIME_MAX_LINES && !got_int;
+									++idx)
+    {
+	p = ((syn_line_time_T *)ga.ga_data) + idx;
+
+	msg_puts(profile_msg(&p->total));
+	msg_puts(" "); // make sure there is always a separating space
+	msg_advance(13);
+	msg_outnum(p->lnum);
+	msg_puts(" ");
+	msg_advance(20);
+	if (p->lnum <= curbuf->b_ml.ml_line_count)
+	{
+	    line = skipwhite(ml_get(p->lnum));
+	    len = Columns < 40 ? 20 : Columns - 21;
+	    if (len > (int)STRLEN(line))
+		len = (int)STRLEN(line);
+	    msg_outtrans_len(line, len);
+	}
+	msg_puts("\n");
+    }
+    ga_clear(&ga);
+    if (!got_int)
+    {
+	msg_puts("\n");
+	msg_puts(_("syncs: "));
+	msg_outnum(curwin->w_s->b_syn_sync_count);
+	msg_puts(_("   state stack allocations: "));
+	msg_outnum(curwin->w_s->b_syn_stack_allocs);
+	msg_puts("\n");
+    }
+}
+
+/*
+ * ":syntime flame": list the time spent for each nesting of syntax groups in
+ * microseconds, one nesting per line in the "folded stacks" format that flame
+ * graph tools use, e.g.:
+ *	cBlock;cParen;cNumber 1234
+ */
+    static void
+syntime_flame(void)
+{
+    hashtab_T	*ht = &curwin->w_s->b_syn_nest_time;
+    hashitem_T	*hi;
+    char_u	**keys;
+    nesttime_T	*ntp;
+    int		count = 0;
+    int		todo;
+    int		idx;
+    char	buf[30];
+
+    if (!syntax_present(curwin))
+    {
+	msg(_(msg_no_items));
+	return;
+    }
+    if (ht->ht_used == 0)
+	return;
+
+    keys = ALLOC_MULT(char_u *, ht->ht_used);
+    if (keys == NULL)
+	return;
+    todo = (int)ht->ht_used;
+    FOR_ALL_HASHTAB_ITEMS(ht, hi, todo)
+	if (!HASHITEM_EMPTY(hi))
+	{
+	    --todo;
+	    keys[count++] = hi->hi_key;
+	}
+    sort_strings(keys, count);
+
+    msg_start();
+    for (idx = 0; idx < count && !got_int; ++idx)
+    {
+	ntp = HIKEY2NT(keys[idx]);
+	msg_outtrans(ntp->nt_key);
+	vim_snprintf(buf, sizeof(buf), " %ld\n",
+			       (long)(profile_float(&ntp->nt_total) * 1000000.0));
+	msg_puts(buf);
+    }
+    vim_free(keys);
+}
 #endif
 
 #endif // FEAT_SYN_HL
@@ -2721,13 +2721,21 @@ termcapinit(char_u *name)
 
 /*
  * The number of calls to ui_write is reduced by using "out_buf".
+ * While updating the screen "out_buf" grows instead of being flushed when it
+ * is full, up to OUT_BATCH_MAX bytes, so that the terminal gets the whole
+ * update at once.
  */
 #define OUT_SIZE	2047
+#define OUT_BATCH_MAX	(256 * 1024)
 
 // add one to allow mch_write() in os_win32.c to append a NUL
-static char_u		out_buf[OUT_SIZE + 1];
+static char_u		out_buf_static[OUT_SIZE + 1];
+static char_u		*out_buf = out_buf_static;
+static int		out_size = OUT_SIZE;	// size of out_buf minus one
+static int		out_limit = OUT_SIZE;	// flush when out_pos reaches this
 
 static int		out_pos = 0;	// number of chars in out_buf
+static int		out_batch = 0;	// nesting of out_batch_start()
 
 // Since the maximum number of SGR parameters shown as a normal value range is
 // 16, the escape sequence length can be 4 * 16 + lead + tail.
@@ -2740,14 +2748,33 @@ static int		out_pos = 0;	// number of chars in out_buf
 out_flush(void)
 {
     int	    len;
+#ifdef FEAT_PROFILE
+    int	    dt_output = drawtime_output;
+    proftime_T dt_tm;
+#endif
 
     if (out_pos == 0)
+    {
+#ifdef UNIX
+	// What out_flush_nowait() left behind must be written now.
+	if (!write_nowait)
+	    mch_write_pending(TRUE);
+#endif
 	return;
+    }
 
     // set out_pos to 0 before ui_write, to avoid recursiveness
     len = out_pos;
     out_pos = 0;
+#ifdef FEAT_PROFILE
+    if (dt_output)
+	profile_start(&dt_tm);
+#endif
     ui_write(out_buf, len, FALSE);
+#ifdef FEAT_PROFILE
+    if (dt_output)
+	drawtime_add(DRAWTIME_OUTPUT, &dt_tm);
+#endif
 #ifdef FEAT_EVAL
     if (ch_log_output != FALSE)
     {
@@ -2762,6 +2789,90 @@ out_flush(void)
 	    ch_log_output = FALSE;  // only log once
     }
 #endif
+
+    // Go back to the normal buffer after a screen update was written.
+    if (out_batch == 0 && out_pos == 0 && out_buf != out_buf_static)
+    {
+	vim_free(out_buf);
+	out_buf = out_buf_static;
+	out_size = OUT_SIZE;
+	out_limit = OUT_SIZE;
+    }
+}
+
+/*
+ * Like out_flush(), but when the terminal is slow don't wait for it to accept
+ * all the output.  The rest is written while waiting for a character.  The
+ * next out_flush() waits for it.
+ */
+    void
+out_flush_nowait(void)
+{
+#ifdef UNIX
+    write_nowait = TRUE;
+    out_flush();
+    write_nowait = FALSE;
+#else
+    out_flush();
+#endif
+}
+
+/*
+ * Called when "out_buf" is full: flush it or, while collecting the output of
+ * a screen update, make it bigger.
+ */
+    static void
+out_buf_full(void)
+{
+    char_u	*p;
+    int		new_size;
+
+    if (out_batch > 0 && out_size < OUT_BATCH_MAX)
+    {
+	new_size = out_size * 2 < OUT_BATCH_MAX ? out_size * 2 : OUT_BATCH_MAX;
+	p = alloc(new_size + 1);
+	if (p != NULL)
+	{
+	    mch_memmove(p, out_buf, (size_t)out_pos);
+	    if (out_buf != out_buf_static)
+		vim_free(out_buf);
+	    out_buf = p;
+	    out_size = new_size;
+	    out_limit = new_size;
+	    return;
+	}
+    }
+    out_flush();
+}
+
+/*
+ * Start collecting the output for a screen update, so that it is written to
+ * the terminal at once.  Outputs "t_BS" to begin a synchronized update, if it
+ * is set.  Must be followed by a call to out_batch_end().
+ */
+    void
+out_batch_start(void)
+{
+    if (out_batch++ > 0)
+	return;
+    out_limit = out_size;
+    if (T_BSU != NULL && *T_BSU != NUL)
+	out_str(T_BSU);
+}
+
+/*
+ * End collecting the output for a screen update, started with
+ * out_batch_start().  Outputs "t_ES", if "t_BS" and "t_ES" are set.  The
+ * output, and what follows until the next flush, is written with the next
+ * flush.
+ */
+    void
+out_batch_end(void)
+{
+    if (out_batch == 0 || --out_batch > 0)
+	return;
+    if (T_BSU != NULL && *T_BSU != NUL && *T_ESU != NUL)
+	out_str(T_ESU);
 }
 
 /*
@@ -2793,8 +2904,8 @@ out_flush_cursor(
     void
 out_flush_check(void)
 {
-    if (enc_dbcs != 0 && out_pos >= OUT_SIZE - MB_MAXBYTES)
-	out_flush();
+    if (enc_dbcs != 0 && out_pos >= out_limit - MB_MAXBYTES)
+	out_buf_full();
 }
 
 #ifdef FEAT_GUI
@@ -2825,8 +2936,10 @@ out_char(unsigned c)
     out_buf[out_pos++] = c;
 
     // For testing we flush each time.
-    if (out_pos >= OUT_SIZE || p_wd)
+    if (p_wd)
 	out_flush();
+    else if (out_pos >= out_limit)
+	out_buf_full();
 }
 
 /*
@@ -2837,8 +2950,8 @@ out_char_nf(int c)
 {
     out_buf[out_pos++] = (unsigned)c;
 
-    if (out_pos >= OUT_SIZE)
-	out_flush();
+    if (out_pos >= out_limit)
+	out_buf_full();
     return (unsigned)c;
 }
 
@@ -2855,8 +2968,8 @@ out_char_nf(int c)
 out_str_nf(char_u *s)
 {
     // avoid terminal strings being split up
-    if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	out_flush();
+    if (out_pos > out_limit - MAX_ESC_SEQ_LEN)
+	out_buf_full();
 
     for (char_u *p = s; *p != NUL; ++p)
 	out_char_nf(*p);
@@ -2890,8 +3003,8 @@ out_str_cf(char_u *s)
 	return;
     }
 #endif
-    if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	out_flush();
+    if (out_pos > out_limit - MAX_ESC_SEQ_LEN)
+	out_buf_full();
 #ifdef HAVE_TGETENT
     for (p = s; *s; ++s)
     {
@@ -2958,8 +3071,8 @@ out_str(char_u *s)
     }
 #endif
     // avoid terminal strings being split up
-    if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	out_flush();
+    if (out_pos > out_limit - MAX_ESC_SEQ_LEN)
+	out_buf_full();
 #ifdef HAVE_TGETENT
     tputs((char *)s, 1, TPUTSFUNCAST out_char_nf);
 #else
@@ -5232,6 +5345,18 @@ handle_version_response(int first, int *arg, int argc, char_u *tp)
 	write_t_8u_state = OK;  // can output t_8u now
 #endif
 
+	// Kitty supports synchronized updates.  Use them, unless "t_BS" was
+	// set already.
+	if (term_props[TPR_KITTY].tpr_status == TPR_YES
+		&& *T_BSU == NUL
+		&& !option_was_set((char_u *)"t_BS"))
+	{
+	    set_string_option_direct((char_u *)"t_BS", -1,
+				      (char_u *)"\033[?2026h", OPT_FREE, 0);
+	    set_string_option_direct((char_u *)"t_ES", -1,
+				      (char_u *)"\033[?2026l", OPT_FREE, 0);
+	}
+
 	// Only set 'ttymouse' automatically if it was not set
 	// by the user already.
 	if (!option_was_set((char_u *)"ttym")
@@ -227,6 +227,28 @@ func Test_display_scroll_at_topline()
   call StopVimInTerminal(buf)
 endfunc
 
+func Test_display_scroll_moved_text()
+  CheckScreendump
+
+  let lines =<< trim END
+      call setline(1, map(range(1, 100), '"line " .. v:val .. repeat(" text", v:val % 5)'))
+      50
+      split
+  END
+  call writefile(lines, 'XtestScrollMoved', 'D')
+  let buf = RunVimInTerminal('-S XtestScrollMoved', #{rows: 16})
+  call VerifyScreenDump(buf, 'Test_display_scroll_moved_1', {})
+
+  " the lower window grows upwards, its text moves up
+  call term_sendkeys(buf, ":resize -3\<CR>")
+  call VerifyScreenDump(buf, 'Test_display_scroll_moved_2', {})
+
+  call term_sendkeys(buf, ":wincmd j | 40 | wincmd k | close\<CR>")
+  call VerifyScreenDump(buf, 'Test_display_scroll_moved_3', {})
+
+  call StopVimInTerminal(buf)
+endfunc
+
 func Test_display_scroll_update_visual()
   CheckScreendump
 
@@ -490,4 +512,55 @@ func Test_display_cursor_long_line()
   call StopVimInTerminal(buf)
 endfunc
 
+func Test_drawtime()
+  CheckFeature profile
+
+  drawtime clear
+  call assert_equal("\nNo screen updates measured", execute('drawtime report'))
+  call assert_equal(0, getdrawtime().count)
+
+  new
+  call setline(1, range(1, 30))
+  drawtime on
+  redraw!
+  normal! G
+  redraw
+  drawtime off
+  redraw!
+
+  let d = getdrawtime()
+  call assert_equal(2, d.count)
+  call assert_equal(2, len(d.frames))
+  call assert_true(d.lines >= winheight(0))
+  call assert_equal(d.lines, d.frames[0].lines + d.frames[1].lines)
+  call assert_true(d.windows[win_getid()] >= winheight(0))
+  call assert_true(d.slowest <= d.total)
+  call assert_true(d.text <= d.total)
+  call assert_equal(2, eval(join(d.histogram, '+')))
+
+  let a = execute('drawtime report')
+  call assert_match('^  TOTAL *COUNT *SLOWEST *AVERAGE *LINES\n *\d*\.\d* \+2 ', a)
+  call assert_match('\n *\d*\.\d* \+\d*\.\d* text\n', a)
+  call assert_match('\n  LINES  WINDOW\n  \d\+ \+' .. win_getid() .. ' ', a)
+
+  call assert_equal(['clear', 'off', 'on', 'report'], getcompletion('drawtime ', 'cmdline'))
+  call assert_fails('drawtime abc', 'E475:')
+
+  " Each update is logged after it was written, with the output time.
+  call ch_logfile('Xdrawlog', 'w')
+  drawtime on
+  redraw!
+  drawtime off
+  call ch_logfile('')
+  let log = readfile('Xdrawlog')->filter('v:val =~ "drawtime: "')
+  call assert_equal(1, len(log))
+  call assert_match('drawtime: total [0-9.]\+ text [0-9.]\+ syntax [0-9.]\+ folds [0-9.]\+ status [0-9.]\+ popups [0-9.]\+ output [0-9.]\+ lines \d\+$', log[0])
+  call delete('Xdrawlog')
+
+  drawtime clear
+  call assert_equal(0, getdrawtime().count)
+  call assert_equal(0, getdrawtime().windows[win_getid()])
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
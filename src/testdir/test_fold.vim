@@ -1914,4 +1914,62 @@ func Test_foldexpr_end_fold()
   bwipe!
 endfunc
 
+" Test that updating the folds evaluates 'foldexpr' at most once for each line.
+" After a change all lines in the updated range are evaluated again.
+func Test_foldexpr_cache()
+  new
+  let g:fde_lines = {}
+  func FoldExprCount()
+    let g:fde_lines[v:lnum] = get(g:fde_lines, v:lnum, 0) + 1
+    return getline(v:lnum) =~ '^#' ? '>1' : '='
+  endfunc
+  call setline(1, range(1000)->map({i, _ -> i % 100 == 0 ? '# head' : 'text'}))
+  setlocal foldexpr=FoldExprCount() foldmethod=expr
+  redraw
+  call assert_equal(1000, len(g:fde_lines))
+  call assert_equal([1], uniq(sort(values(g:fde_lines))))
+  call assert_equal([501, 600], [foldclosed(550), foldclosedend(550)])
+
+  " After a change each line is evaluated at most once
+  let g:fde_lines = {}
+  call setline(550, 'changed')
+  call assert_equal([1], uniq(sort(values(g:fde_lines))))
+  let g:fde_lines = {}
+  call setline(550, '# head')
+  call assert_equal([1], uniq(sort(values(g:fde_lines))))
+  call assert_equal([550, 600], [foldclosed(550), foldclosedend(550)])
+  call assert_equal([501, 549], [foldclosed(520), foldclosedend(520)])
+
+  " "zX" evaluates all lines again
+  let g:fde_lines = {}
+  normal! zX
+  call assert_equal(1, foldlevel(1))
+  call assert_equal(1000, len(g:fde_lines))
+
+  " A result that depends on another line is evaluated again
+  let &l:foldexpr = 'getline(2) == "long" || v:lnum < 3'
+  call setline(2, 'short')
+  call assert_equal(2, foldclosedend(1))
+  call setline(2, 'long')
+  call assert_equal(1000, foldclosedend(1))
+
+  bwipe!
+  delfunc FoldExprCount
+  unlet g:fde_lines
+endfunc
+
+" Test that a change updates the folds for a 'foldexpr' that looks at a line
+" further away before the next command is executed.
+func Test_foldexpr_cache_far_line()
+  new
+  call setline(1, ['# head'] + repeat(['text'], 19))
+  setlocal foldexpr=getline(v:lnum)=~'^#'?'>1':getline(v:lnum+3)=='END'?'<1':'='
+  setlocal foldmethod=expr
+  call assert_equal(20, foldclosedend(1))
+  call setline(10, 'END')
+  normal! 1Gzcdd
+  call assert_equal(13, line('$'))
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
@@ -4011,6 +4011,34 @@ func Test_virtcol()
   bwipe!
 endfunc
 
+" Virtual columns in a long line are cached, check they are updated.
+func Test_virtcol_long_line()
+  new
+  let line = repeat("ab\tcd日本", 2000)
+  call setline(1, line)
+  for idx in [0, 1500, 4000, 7001, 9000, 3500, 13999, 1100]
+    let col = byteidx(line, idx)
+    let vcol = strdisplaywidth(strpart(line, 0, col)) + 1
+    call assert_equal(vcol, virtcol([1, col + 1], v:true)[0], 'col ' .. col)
+  endfor
+  call assert_equal(strdisplaywidth(line), virtcol([1, '$']) - 1)
+
+  " changing the text
+  let line = 'x' .. line
+  call setline(1, line)
+  let col = byteidx(line, 9000)
+  call assert_equal(strdisplaywidth(strpart(line, 0, col)) + 1,
+        \ virtcol([1, col + 1], v:true)[0])
+
+  " changing 'tabstop'
+  setlocal tabstop=4
+  call assert_equal(strdisplaywidth(strpart(line, 0, col)) + 1,
+        \ virtcol([1, col + 1], v:true)[0])
+  call assert_equal(strdisplaywidth(line), virtcol([1, '$']) - 1)
+
+  bwipe!
+endfunc
+
 func Test_delfunc_while_listing()
   CheckRunVimInTerminal
 
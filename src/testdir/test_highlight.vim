@@ -774,6 +774,36 @@ func Test_visual_sbr()
   call StopVimInTerminal(buf)
 endfunc
 
+func Test_highlight_color_change()
+  CheckScreendump
+
+  " Only the colors change between these groups, check that switching between
+  " them directly and going back to Normal works.
+  let lines =<< trim END
+      hi Normal ctermfg=white ctermbg=darkblue
+      hi OnlyFg ctermfg=yellow
+      hi OnlyBg ctermbg=darkred
+      hi FgBg ctermfg=black ctermbg=lightgreen
+      hi BoldFg cterm=bold ctermfg=cyan
+      call setline(1, ['one two three four five', 'six seven eight nine'])
+      call matchadd('OnlyFg', 'one\|six')
+      call matchadd('OnlyBg', 'two\|seven')
+      call matchadd('FgBg', 'three\|eight')
+      call matchadd('BoldFg', 'four\|nine')
+  END
+  call writefile(lines, 'Xtest_color_change', 'D')
+  let buf = RunVimInTerminal('-S Xtest_color_change', {'rows': 6, 'cols': 40})
+  call VerifyScreenDump(buf, 'Test_highlight_color_change_1', {})
+
+  call term_sendkeys(buf, ":set termguicolors\<CR>")
+  call term_sendkeys(buf, ":hi Normal guifg=white guibg=darkblue\<CR>")
+  call term_sendkeys(buf, ":hi OnlyFg guifg=yellow | hi OnlyBg guibg=darkred\<CR>")
+  call term_sendkeys(buf, ":hi FgBg guifg=black guibg=lightgreen | hi BoldFg gui=bold guifg=cyan\<CR>")
+  call VerifyScreenDump(buf, 'Test_highlight_color_change_2', {})
+
+  call StopVimInTerminal(buf)
+endfunc
+
 " This test must come before the Test_cursorline test, as it appears this
 " defines the Normal highlighting group anyway.
 func Test_1_highlight_Normalgroup_exists()
@@ -110,4 +110,51 @@ func Test_hlsearch_clipboard()
   call StopVimInTerminal(buf)
 endfunc
 
+" Matches are cached per window, changed lines must be searched again.
+func Test_hlsearch_after_change()
+  new
+  call setline(1, ['xxx', 'aaa', 'xxx', 'aaa'])
+  set hlsearch nolazyredraw
+  let @/ = 'aaa'
+  redraw
+  let attr = screenattr(2, 1)
+  call assert_notequal(attr, screenattr(1, 1))
+
+  call setline(1, 'aaa')
+  3delete
+  redraw
+  call assert_equal([attr, attr, attr], [screenattr(1, 1), screenattr(2, 1),
+        \ screenattr(3, 1)])
+  call append(0, 'xxx')
+  redraw
+  call assert_equal([0, attr, attr, attr], [screenattr(1, 1),
+        \ screenattr(2, 1), screenattr(3, 1), screenattr(4, 1)])
+  call setline(3, 'xxx')
+  redraw
+  call assert_equal([0, attr, 0, attr], [screenattr(1, 1),
+        \ screenattr(2, 1), screenattr(3, 1), screenattr(4, 1)])
+
+  set nohlsearch
+  bwipe!
+endfunc
+
+" Cached matches are dropped when 'isident' changes what "\i" matches.
+func Test_hlsearch_after_isident_change()
+  new
+  call setline(1, ['a-b', 'xxx'])
+  set hlsearch nolazyredraw
+  let @/ = 'a\ib'
+  redraw!
+  call assert_equal(screenattr(2, 1), screenattr(1, 1))
+
+  let save_isident = &isident
+  set isident+=-
+  redraw!
+  call assert_notequal(screenattr(2, 1), screenattr(1, 1))
+
+  let &isident = save_isident
+  set nohlsearch
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
@@ -234,6 +234,54 @@ func Test_matchaddpos_dump()
   call StopVimInTerminal(buf)
 endfunc
 
+" Many positions, not in order, and many matches.
+func Test_matchaddpos_many()
+  syntax on
+  new
+  call setline(1, repeat(['abcdefghij'], 1000))
+  let pos = []
+  for lnum in range(1000, 1, -1)
+    let pos += [[lnum, 7, 2], [lnum, 2]]
+  endfor
+  call matchaddpos('Search', pos)
+  " getmatches() keeps the order
+  call assert_equal([1000, 7, 2], getmatches()[0].pos1)
+  call assert_equal([1000, 2, 1], getmatches()[0].pos2)
+  for lnum in range(1, 1000, 10)
+    call matchaddpos('Error', [lnum + 1, [lnum, 4]], 20)
+  endfor
+
+  normal! 501Gzt
+  redraw!
+  let search = screenattr(1, 2)
+  let error = screenattr(1, 4)
+  call assert_notequal(0, search)
+  call assert_notequal(0, error)
+  call assert_notequal(search, error)
+  call assert_equal(0, screenattr(1, 1))
+  call assert_equal(0, screenattr(1, 3))
+  call assert_equal(search, screenattr(1, 7))
+  call assert_equal(search, screenattr(1, 8))
+  call assert_equal(0, screenattr(1, 9))
+  " whole line 502 with a higher priority
+  call assert_equal(error, screenattr(2, 1))
+  call assert_equal(error, screenattr(2, 7))
+  call assert_equal(0, screenattr(3, 1))
+  call assert_equal(search, screenattr(3, 2))
+  call assert_equal(0, screenattr(3, 4))
+
+  " a match is found after going back
+  normal! 11Gzt
+  redraw!
+  call assert_equal(search, screenattr(1, 2))
+  call assert_equal(error, screenattr(1, 4))
+  call assert_equal(error, screenattr(2, 1))
+
+  call clearmatches()
+  bwipe!
+  syntax off
+endfunc
+
 func Test_matchaddpos_otherwin()
   syntax on
   new
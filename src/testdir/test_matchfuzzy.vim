@@ -26,6 +26,10 @@ func Test_matchfuzzy()
   " matches with same score should not be reordered
   let l = ['abc1', 'abc2', 'abc3']
   call assert_equal(l, l->matchfuzzy('abc'))
+  " characters must be in order, words in any order, case is ignored
+  call assert_equal([], matchfuzzy(['cba', 'bca', 'ab'], 'abc'))
+  call assert_equal(['Two One'], matchfuzzy(['Two One', 'Two'], 'one TWO'))
+  call assert_equal([], matchfuzzy(['Two One'], 'one two', {'matchseq': 1}))
 
   " Tests for match preferences
   " preference for camel case match
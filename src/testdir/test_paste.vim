@@ -70,6 +70,38 @@ func Test_paste_insert_mode()
   bwipe!
 endfunc
 
+" folds are adjusted once for all pasted lines
+func Test_paste_insert_mode_folds()
+  CheckFeature folding
+
+  new
+  call setline(1, ['a', '  b', '  c', 'd', '  e', '  f', 'g'])
+  setlocal foldenable foldmethod=indent foldlevel=0 shiftwidth=2
+  call assert_equal([2, 3], [foldclosed(3), foldclosedend(2)])
+  call assert_equal([5, 6], [foldclosed(6), foldclosedend(5)])
+  4
+  call feedkeys("o\<Esc>[200~x\<CR>  y\<CR>  z\<CR>w\<Esc>[201~\<Esc>", 'xt')
+  call assert_equal(['d', 'x', '  y', '  z', 'w', '  e'], getline(4, 9))
+  call assert_equal([2, 3], [foldclosed(3), foldclosedend(2)])
+  " the new fold was opened for the cursor, the one below stays closed
+  call assert_equal([-1, -1, 1], [foldclosed(6), foldclosed(7), foldlevel(7)])
+  call assert_equal([9, 10], [foldclosed(10), foldclosedend(9)])
+
+  " manual folds below the cursor move down, the fold above includes the
+  " pasted lines
+  %d
+  call setline(1, ['a', 'b', 'c', 'd', 'e', 'f'])
+  setlocal foldmethod=manual
+  1,2fold
+  5,6fold
+  2
+  call feedkeys("A\<Esc>[200~\<CR>x\<CR>y\<Esc>[201~\<Esc>", 'xt')
+  call assert_equal(['a', 'b', 'x', 'y', 'c'], getline(1, 5))
+  call assert_equal([1, 1, 1, 1, 0], map(range(1, 5), 'foldlevel(v:val)'))
+  call assert_equal([7, 8], [foldclosed(8), foldclosedend(7)])
+  bwipe!
+endfunc
+
 func Test_paste_clipboard()
   CheckFeature clipboard_working
 
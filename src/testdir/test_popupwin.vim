@@ -4287,6 +4287,41 @@ func Test_popupwin_with_error()
   call StopVimInTerminal(buf)
 endfunc
 
+" Creating, moving and closing a popup only redraws what is below it.
+func Test_popupwin_redraw_below()
+  CheckFeature profile
+  new
+  call setline(1, range(1, 20)->map('repeat(v:val, 10)'))
+  redraw
+  let winid = win_getid()
+
+  drawtime on
+  redraw
+  drawtime clear
+  let id = popup_create(['xxx', 'yyy'], #{line: 3, col: 5})
+  redraw
+  call assert_equal('xxx', range(5, 7)->map('screenstring(3, v:val)')->join(''))
+  " lines below the popup may be redrawn, not the whole window
+  call assert_inrange(0, 2, getdrawtime().windows[winid])
+
+  drawtime clear
+  call popup_move(id, #{line: 5})
+  redraw
+  call assert_equal('333', range(5, 7)->map('screenstring(3, v:val)')->join(''))
+  call assert_equal('xxx', range(5, 7)->map('screenstring(5, v:val)')->join(''))
+  call assert_inrange(2, 4, getdrawtime().windows[winid])
+
+  drawtime clear
+  call popup_close(id)
+  redraw
+  call assert_equal('555', range(5, 7)->map('screenstring(5, v:val)')->join(''))
+  call assert_equal('666', range(5, 7)->map('screenstring(6, v:val)')->join(''))
+  call assert_equal(2, getdrawtime().windows[winid])
+
+  drawtime off
+  bwipe!
+endfunc
+
 func Test_popup_close_callback_recursive()
   set maxfuncdepth=20
   " this invokes the callback recursively
@@ -109,6 +109,50 @@ func Test_mouse_scroll_inactive_with_cursorbind()
   endfor
 endfunc
 
+" The number of screen lines of a buffer line is cached, check that it is
+" updated when the text or a setting changes.
+func Test_scroll_line_height_changed()
+  func s:Winline(lnum)
+    call winrestview(#{topline: 1, lnum: a:lnum})
+    return winline()
+  endfunc
+
+  new
+  let width = winwidth(0)
+  call setline(1, [repeat('x', width * 3), 'two', 'three', 'four'])
+  call assert_equal(6, s:Winline(4))
+
+  " change the text in another window
+  let buf = bufnr()
+  wincmd p
+  let save_buf = bufnr()
+  exe 'buffer' buf
+  call setline(1, repeat('x', width + 1))
+  wincmd w
+  call assert_equal(5, s:Winline(4))
+  wincmd w
+  call append(0, repeat('y', width * 2))
+  wincmd w
+  call assert_equal(7, s:Winline(5))
+
+  " change a global setting in another window
+  wincmd w
+  set showbreak=>>>
+  wincmd w
+  call assert_equal(8, s:Winline(5))
+  call setline(1, repeat('y', width * 2 - 3))
+  call assert_equal(7, s:Winline(5))
+  call setline(1, repeat('y', width * 2 - 2))
+  call assert_equal(8, s:Winline(5))
+
+  set showbreak&
+  wincmd w
+  exe 'buffer' save_buf
+  wincmd w
+  bwipe!
+  delfunc s:Winline
+endfunc
+
 func Test_CtrlE_CtrlY_stop_at_end()
   enew
   call setline(1, ['one', 'two'])
@@ -1188,4 +1232,75 @@ func Test_smooth_long_scrolloff()
   call StopVimInTerminal(buf)
 endfunc
 
+" Displaying the end of a long line starts from a cached position.
+func Test_smoothscroll_very_long_line_text()
+  new
+  let text = repeat("abc\td\u00e9f ", 400) .. 'END'
+  call setline(1, text)
+  " Text as it is displayed, with Tabs expanded.
+  let shown = ''
+  for c in split(text, '\zs')
+    let shown ..= c == "\t" ? repeat(' ', 8 - strwidth(shown) % 8) : c
+  endfor
+  let width = winwidth(0)
+
+  setlocal smoothscroll nowrap
+  normal! $
+  redraw
+  let shown ..= repeat(' ', width)
+  let leftcol = winsaveview().leftcol
+  call assert_true(leftcol > 1024)
+  call assert_equal(strcharpart(shown, leftcol, width),
+        \ join(map(range(1, width), 'screenstring(1, v:val)'), ''))
+
+  setlocal wrap
+  exe "normal! gg0" .. (&lines) .. "\<C-E>"
+  redraw
+  let skipcol = winsaveview().skipcol
+  call assert_true(skipcol > 1024)
+  " The first three cells show "<<<".
+  call assert_equal(strcharpart(shown, skipcol + 3, width - 3),
+        \ join(map(range(4, width), 'screenstring(1, v:val)'), ''))
+
+  bwipe!
+endfunc
+
+" Several long lines with 'nowrap' are displayed correctly with a small and a
+" large 'leftcol'.
+func Test_nowrap_several_long_lines()
+  new
+  let lines = map(range(1, 5), {_, n -> repeat(n .. "\tab\u00e9c", 600)})
+  call setline(1, lines)
+  " Text as it is displayed, with Tabs expanded.
+  let shown = []
+  for text in lines
+    let s = ''
+    for c in split(text, '\zs')
+      let s ..= c == "\t" ? repeat(' ', 8 - strwidth(s) % 8) : c
+    endfor
+    call add(shown, s)
+  endfor
+  let width = winwidth(0)
+
+  setlocal nowrap
+  normal! 3G5zl
+  redraw
+  for lnum in range(1, 5)
+    call assert_equal(strcharpart(shown[lnum - 1], 5, width),
+          \ join(map(range(1, width), {_, c -> screenstring(lnum, c)}), ''))
+  endfor
+
+  " The cursor line uses the cache, the other lines do not.
+  normal! 3G3000|
+  redraw
+  let leftcol = winsaveview().leftcol
+  call assert_true(leftcol > 1024)
+  for lnum in range(1, 5)
+    call assert_equal(strcharpart(shown[lnum - 1], leftcol, width),
+          \ join(map(range(1, width), {_, c -> screenstring(lnum, c)}), ''))
+  endfor
+
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
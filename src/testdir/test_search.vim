@@ -1395,6 +1395,75 @@ func Test_word_under_cursor_after_match()
   set noincsearch
 endfunc
 
+func Test_incsearch_continues_after_timeout()
+  CheckOption incsearch
+  CheckFeature reltime
+
+  " searching takes more than the half second time limit, the search
+  " continues until the match at the end is found
+  new
+  call setline(1, repeat(['abc def ghi jkl mno pqr stu vwx yz'], 40000)
+        \ + ['abc XYZdef'])
+  set incsearch
+  call test_override("char_avail", 1)
+  let g:pat = '\v(\w+\s*)+XY'
+  try
+    call feedkeys("/\<C-R>=g:pat\<CR>Z\<C-R>\<C-W>\<CR>", 'ntx')
+  catch /E486:/
+  endtry
+  call assert_equal(g:pat .. 'Zdef', @/)
+
+  bwipe!
+  unlet g:pat
+  call test_override("ALL", 0)
+  set noincsearch
+endfunc
+
+" Searching skips over memline blocks that do not contain the text every
+" match must have, check that matches are still found in the right place.
+func Test_search_skips_blocks()
+  new
+  call setline(1, repeat(['abc def ghi jkl mno pqr stu vwx yz'], 20000))
+  call setline(3000, 'xx foobar foo')
+  call setline(9000, 'foo')
+  call setline(15000, 'xx notfo')
+  call setline(15001, 'o here')
+  " also in the text property of a line
+  if has('textprop')
+    call prop_type_add('skip', {})
+    call prop_add(12000, 1, {'type': 'skip', 'text': 'foo'})
+  endif
+
+  for engine in [0, 1, 2]
+    let &regexpengine = engine
+    call cursor(1, 1)
+    call assert_equal([3000, 4], searchpos('foo', 'W'))
+    call assert_equal([3000, 11], searchpos('\<foo\>', 'W'))
+    call assert_equal([9000, 1], searchpos('\<foo\>', 'W'))
+    call assert_equal([0, 0], searchpos('\<foo\>', 'W'))
+    call assert_equal([3000, 4], searchpos('foo', 'w'))
+    call assert_equal([3000, 11], searchpos('foo', 'W', 8999))
+    call assert_equal([0, 0], searchpos('foo', 'W', 8999))
+    call assert_equal([3000, 4], searchpos('foo', 'bw'))
+    call assert_equal([9000, 1], searchpos('foo', 'b'))
+    call assert_equal([3000, 11], searchpos('foo', 'b'))
+    call cursor(10000, 1)
+    call assert_equal([0, 0], searchpos('foo', 'bW', 9001))
+    call assert_equal([9000, 1], searchpos('\<foo\>', 'w', 0, 0,
+          \ {-> line('.') == 3000}))
+    call assert_equal([3000, 11], searchpos('\cFOO', 'bW'))
+    call assert_equal([0, 0], searchpos('notfoo', 'w'))
+    call assert_equal([15000, 4], searchpos('notfo\no', 'w'))
+    call assert_equal([3000, 4], searchpos('foo', 'w'))
+  endfor
+
+  set regexpengine&
+  if has('textprop')
+    call prop_type_delete('skip')
+  endif
+  bwipe!
+endfunc
+
 func Test_subst_word_under_cursor()
   CheckOption incsearch
 
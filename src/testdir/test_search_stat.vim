@@ -459,4 +459,76 @@ func Test_search_stat_backwards()
   call StopVimInTerminal(buf)
 endfunc
 
+" The count is updated for changed lines only, check it matches a full count.
+func Test_searchcount_after_changes()
+  new
+  call setline(1, repeat(['foo bar foo', 'xx', 'foobar'], 100))
+  call assert_equal(
+    \ #{current: 2, exact_match: 0, total: 300, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pattern: 'foo', pos: [2, 1, 0], maxcount: 0}))
+
+  let @/ = 'foo'
+  call setline(2, 'foo')
+  call assert_equal(
+    \ #{current: 3, exact_match: 1, total: 301, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [2, 1, 0], maxcount: 0}))
+  3,5delete
+  call assert_equal(
+    \ #{current: 4, exact_match: 1, total: 298, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [3, 1, 0], maxcount: 0}))
+  call append(1, ['foofoo', 'xfoo'])
+  call assert_equal(
+    \ #{current: 5, exact_match: 1, total: 301, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [3, 4, 0], maxcount: 0}))
+  call assert_equal(
+    \ #{current: 5, exact_match: 0, total: 301, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [3, 7, 0], maxcount: 0}))
+  keeppatterns %s/foo bar //
+  call assert_equal(
+    \ #{current: 3, exact_match: 0, total: 202, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [3, 1, 0], maxcount: 0}))
+
+  " a smaller maxcount uses the same matches
+  call assert_equal(
+    \ #{current: 3, exact_match: 0, total: 11, incomplete: 2, maxcount: 10},
+    \ searchcount(#{pos: [3, 1, 0], maxcount: 10}))
+
+  " a pattern that depends on the line number is counted again
+  let @/ = 'foo\%<10l'
+  call assert_equal(
+    \ #{current: 3, exact_match: 0, total: 9, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [3, 1, 0], maxcount: 0}))
+  1delete
+  call assert_equal(
+    \ #{current: 2, exact_match: 0, total: 8, incomplete: 0, maxcount: 0},
+    \ searchcount(#{pos: [2, 1, 0], maxcount: 0}))
+
+  " changing 'iskeyword' changes what "\<" matches
+  call setline(1, ['foo-bar', 'foo-bar', 'foobar'])
+  let @/ = '\<bar'
+  call assert_equal(2, searchcount(#{pos: [1, 1, 0], maxcount: 0}).total)
+  setlocal iskeyword+=-
+  call assert_equal(0, searchcount(#{pos: [1, 1, 0], maxcount: 0}).total)
+  setlocal iskeyword&
+
+  " changing 'isident' changes what "\i" matches
+  call setline(1, ['a-b', 'a-b', 'ab'])
+  let @/ = 'a\ib'
+  call assert_equal(0, searchcount(#{pos: [1, 1, 0], maxcount: 0}).total)
+  set isident+=-
+  call assert_equal(2, searchcount(#{pos: [1, 1, 0], maxcount: 0}).total)
+  set isident&
+
+  " matches depending on the cursor position are not kept
+  %d
+  call setline(1, repeat(['foo'], 10))
+  let @/ = 'foo\%>.l'
+  call cursor(1, 1)
+  call assert_equal(9, searchcount(#{pos: [1, 1, 0], maxcount: 0}).total)
+  call cursor(8, 1)
+  call assert_equal(2, searchcount(#{pos: [8, 1, 0], maxcount: 0}).total)
+
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
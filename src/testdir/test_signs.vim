@@ -1732,6 +1732,55 @@ func Test_sign_lnum_adjust()
   enew!
 endfunc
 
+" Signs in a buffer with many signs are found by line number
+func Test_sign_many_lines()
+  enew! | only!
+  sign define sign1 text=#>
+  sign define sign2 text=!!
+  call setline(1, range(1, 2000))
+
+  " place in random order, some lines get two signs
+  for lnum in range(1, 2000, 7) + range(1995, 2, -11)
+    call sign_place(lnum, '', 'sign1', '', {'lnum': lnum})
+  endfor
+  call sign_place(5000, '', 'sign2', '', {'lnum': 1996, 'priority': 20})
+  let lnums = sign_getplaced('')[0].signs->map('v:val.lnum')
+  call assert_equal(sort(copy(lnums), 'n'), lnums)
+  call assert_equal(len(uniq(sort(range(1, 2000, 7) + range(1995, 2, -11)))) + 1,
+        \ len(lnums))
+  call assert_equal([5000, 1996], sign_getplaced('', {'lnum': 1996})[0].signs
+        \ ->map('v:val.id'))
+
+  " updating a sign keeps the order by priority
+  call sign_place(1996, '', 'sign1', '', {'lnum': 1996, 'priority': 30})
+  call assert_equal([1996, 5000], sign_getplaced('', {'lnum': 1996})[0].signs
+        \ ->map('v:val.id'))
+
+  " drawing uses the sign with the highest priority
+  normal! 1996Gzt
+  redraw
+  call assert_equal('#>1996', join(map(range(1, 6), 'screenstring(1, v:val)'), ''))
+  call sign_unplace('', {'id': 1996})
+  redraw
+  call assert_equal('!!1996', join(map(range(1, 6), 'screenstring(1, v:val)'), ''))
+  call assert_equal('  1997', join(map(range(1, 6), 'screenstring(2, v:val)'), ''))
+
+  " inserting lines moves the signs below
+  call append(1000, ['a', 'b'])
+  call assert_equal([5000], sign_getplaced('', {'lnum': 1998})[0].signs
+        \ ->map('v:val.id'))
+  call assert_equal(1998, sign_getplaced('', {'id': 5000})[0].signs[0].lnum)
+  call sign_place(6000, '', 'sign2', '', {'lnum': 1998, 'priority': 25})
+  call assert_equal([6000, 5000], sign_getplaced('', {'lnum': 1998})[0].signs
+        \ ->map('v:val.id'))
+
+  sign unplace * group=*
+  call assert_equal([], sign_getplaced('')[0].signs)
+  sign undefine sign1
+  sign undefine sign2
+  enew!
+endfunc
+
 " Test for changing the type of a placed sign
 func Test_sign_change_type()
   enew! | only!
@@ -511,6 +511,31 @@ func Test_statusline_using_mode()
   call StopVimInTerminal(buf)
 endfunc
 
+" Only a status line using mode() is redrawn when entering the command line.
+func Test_statusline_using_mode_redraw()
+  func StlCount(name, use_mode)
+    let g:stl_count[a:name] = get(g:stl_count, a:name, 0) + 1
+    return a:use_mode ? mode() : a:name
+  endfunc
+  let g:stl_count = {}
+  setlocal statusline=%{StlCount('a',0)}
+  split
+  setlocal statusline=%{StlCount('b',1)}
+  redraw
+  call assert_equal(#{a: 1, b: 1}, g:stl_count)
+
+  let g:stl_count = {}
+  call feedkeys(":\<Esc>", 'xt')
+  redraw
+  call assert_equal(0, get(g:stl_count, 'a', 0))
+  call assert_notequal(0, get(g:stl_count, 'b', 0))
+
+  close
+  setlocal statusline&
+  unlet g:stl_count
+  delfunc StlCount
+endfunc
+
 func Test_statusline_after_split_vsplit()
   only
 
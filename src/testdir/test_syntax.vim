@@ -88,6 +88,44 @@ func Test_syn_iskeyword()
   quit!
 endfunc
 
+func Test_syn_keyword_case()
+  new
+  call setline(1, ['Int int INT if IF iF ifx x if', 'Über über ÜBER ubr'])
+  syn keyword T int
+  syn case ignore
+  syn keyword S if über
+  syn case match
+  call AssertHighlightGroups(1, 1, '    TTT     SS SS SS       SS')
+  call assert_equal('S', synIDattr(synID(2, 1, 1), 'name'))
+  call assert_equal('S', synIDattr(synID(2, 7, 1), 'name'))
+  call assert_equal('S', synIDattr(synID(2, 14, 1), 'name'))
+  call assert_equal('', synIDattr(synID(2, 20, 1), 'name'))
+  syn clear
+  bw!
+endfunc
+
+" Patterns that cannot start a match in a line are skipped quickly, check
+" that this does not drop any match.
+func Test_syn_match_start_bytes()
+  new
+  call setline(1, ['x = 12 + y', 'abc ABC', 'f(bar(1)) x', 'no match', 'aé= xÉ='])
+  syn match N '\<\d\+'
+  syn match I '\cabc'
+  syn match E '[éÉ]='
+  syn region P start='\%(foo\|bar\)(' end=')'
+  syn match X '\%(x\|y\)\>'
+  call AssertHighlightGroups(1, 1, 'X   NN   X')
+  call AssertHighlightGroups(2, 1, 'III III')
+  call AssertHighlightGroups(3, 1, '  PPPPPP  X')
+  call AssertHighlightGroups(4, 1, '        ')
+  call assert_equal('E', synIDattr(synID(5, 2, 1), 'name'))
+  call assert_equal('E', synIDattr(synID(5, 4, 1), 'name'))
+  call assert_equal('', synIDattr(synID(5, 6, 1), 'name'))
+  call assert_equal('E', synIDattr(synID(5, 7, 1), 'name'))
+  syn clear
+  bw!
+endfunc
+
 func Test_syntax_after_reload()
   split Xsomefile
   call setline(1, ['hello', 'there'])
@@ -139,11 +177,69 @@ func Test_syntime()
   bd
 endfunc
 
+func Test_syntime_lines_flame()
+  CheckFeature profile
+
+  syntax on
+  let a = execute('syntime lines')
+  call assert_equal("\nNo Syntax items defined for this buffer", a)
+
+  new
+  call setline(1, ['a (b [c d] e) f', 'g', 'h [i] j'])
+  syn match Word '\a'
+  syn region Paren start='(' end=')' contains=Word,Bracket
+  syn region Bracket start='\[' end='\]' contains=Word
+  syntime on
+  redraw!
+  let a = execute('syntime lines')
+  call assert_match('^  TOTAL *LINE *TEXT', a)
+  call assert_match(' \d*\.\d* \+1 \+a (b \[c d\] e) f', a)
+  call assert_match(' \d*\.\d* \+3 \+h \[i\] j', a)
+  call assert_match('syncs: 1 \+state stack allocations: 1', a)
+
+  " The nesting is only timed with ":syntime on flame".
+  call assert_equal('', execute('syntime flame'))
+
+  " The line times move with inserted and deleted lines.
+  call append(0, ['x', 'y'])
+  redraw!
+  let a = execute('syntime lines')
+  call assert_match(' \d*\.\d* \+3 \+a (b \[c d\] e) f', a)
+  call assert_match(' \d*\.\d* \+5 \+h \[i\] j', a)
+  3,4delete
+  redraw!
+  let a = execute('syntime lines')
+  call assert_match(' \d*\.\d* \+3 \+h \[i\] j', a)
+  call assert_notmatch(' \+[45] \+', a)
+
+  syntime clear
+  syntime on flame
+  %delete
+  call setline(1, ['a (b [c d] e) f', 'g', 'h [i] j'])
+  redraw!
+  let a = execute('syntime flame')->split("\n")
+  call assert_notequal(-1, match(a, '^Word \d\+$'))
+  call assert_notequal(-1, match(a, '^Paren;Word \d\+$'))
+  call assert_notequal(-1, match(a, '^Paren;Bracket;Word \d\+$'))
+  call assert_notequal(-1, match(a, '^Bracket;Word \d\+$'))
+  call assert_equal(sort(copy(a)), a)
+
+  syntime off
+  syntime clear
+  let a = execute('syntime lines')
+  call assert_notmatch(' \d*\.\d* \+1 ', a)
+  call assert_match('syncs: 0 \+state stack allocations: 0', a)
+  call assert_equal('', execute('syntime flame'))
+
+  syn clear
+  bw!
+endfunc
+
 func Test_syntime_completion()
   CheckFeature profile
 
   call feedkeys(":syntime \<C-A>\<C-B>\"\<CR>", 'tx')
-  call assert_equal('"syntime clear off on report', @:)
+  call assert_equal('"syntime clear flame lines off on report', @:)
 endfunc
 
 func Test_syntax_list()
@@ -978,4 +1074,116 @@ func Test_WinEnter_synstack_synID()
 endfunc
 
 
+func s:DefineReloadSyntax()
+  syn clear
+  syn region Comment start='/\*' end='\*/'
+  syn keyword Type int
+  syn sync fromstart
+endfunc
+
+func s:WriteAndReload(lines)
+  " Need to wait until the timestamp would change.
+  if has('nanotime')
+    sleep 10m
+  else
+    sleep 2
+  endif
+  call writefile(a:lines, 'Xsynreload')
+  checktime
+endfunc
+
+" Syntax states before the first changed line are kept when reloading a
+" buffer, the ones after it must be recomputed.
+func Test_syntax_states_after_reload()
+  CheckUnix
+
+  let lines = ['/* start'] + repeat(['int x;'], 100) + ['*/']
+        \ + repeat(['int y;'], 100)
+  call writefile(lines, 'Xsynreload', 'D')
+  set autoread
+  edit Xsynreload
+  call s:DefineReloadSyntax()
+  call assert_equal('Comment', synIDattr(synID(50, 1, 1), 'name'))
+  call assert_equal('Type', synIDattr(synID(150, 1, 1), 'name'))
+
+  " Change after line 50: states before it can be used.
+  let lines[120] = '/* again'
+  call s:WriteAndReload(lines)
+  call assert_equal('Comment', synIDattr(synID(50, 1, 1), 'name'))
+  call assert_equal('Comment', synIDattr(synID(150, 1, 1), 'name'))
+
+  " Change in the first line: all states must be recomputed.
+  let lines[0] = 'int a;'
+  call s:WriteAndReload(lines)
+  call assert_equal('Type', synIDattr(synID(50, 1, 1), 'name'))
+  call assert_equal('Comment', synIDattr(synID(150, 1, 1), 'name'))
+
+  " Same when the syntax is defined again by an autocommand.
+  augroup SynReload
+    au BufReadPost Xsynreload call s:DefineReloadSyntax()
+  augroup END
+  let lines[0] = '/* start'
+  call s:WriteAndReload(lines)
+  call assert_equal('Comment', synIDattr(synID(50, 1, 1), 'name'))
+  let lines[120] = 'int b;'
+  call s:WriteAndReload(lines)
+  call assert_equal('Comment', synIDattr(synID(50, 1, 1), 'name'))
+  call assert_equal('Type', synIDattr(synID(150, 1, 1), 'name'))
+
+  " A different syntax definition drops the states.
+  augroup SynReload
+    au! BufReadPost Xsynreload syn clear | syn keyword Type int
+  augroup END
+  let lines[10] = 'int c;'
+  call s:WriteAndReload(lines)
+  call assert_equal('Type', synIDattr(synID(5, 1, 1), 'name'))
+  call assert_equal('Type', synIDattr(synID(50, 1, 1), 'name'))
+
+  au! SynReload
+  augroup! SynReload
+  set autoread&
+  bwipe!
+endfunc
+
+" While waiting for a key syntax states are computed for the rest of the file.
+func Test_syntax_idle_parse()
+  CheckRunVimInTerminal
+
+  let lines =<< trim END
+    call setline(1, ['/* start'] + repeat(['int x; /* a */'], 30000) + ['*/']
+          \ + repeat(['int y;'], 30000) + ['/* again'] + repeat(['int z;'], 30000))
+    syn region Comment start='/\*' end='\*/'
+    syn keyword Type int
+    syn sync fromstart
+    redraw
+    let g:first_state = test_getvalue('syn_last_state')
+    func CheckStates(timer)
+      if test_getvalue('syn_last_state') > 80000
+        call writefile([g:first_state], 'Xidle_states')
+        call timer_stop(a:timer)
+      endif
+    endfunc
+    call timer_start(50, 'CheckStates', {'repeat': -1})
+  END
+  call writefile(lines, 'XTest_idle_parse', 'D')
+  let buf = RunVimInTerminal('-S XTest_idle_parse', {'rows': 6})
+
+  " Without a redraw the states are stored beyond the screen lines.
+  call WaitForAssert({-> assert_true(filereadable('Xidle_states'))}, 10000)
+  call assert_inrange(1, 100, str2nr(readfile('Xidle_states')[0]))
+  call delete('Xidle_states')
+
+  call term_sendkeys(buf, "50%")
+  call term_sendkeys(buf, ":echo synIDattr(synID(line('.'), 1, 1), 'name')\r")
+  call WaitForAssert({-> assert_match('^Type', term_getline(buf, 6))})
+  call term_sendkeys(buf, "G")
+  call term_sendkeys(buf, ":echo synIDattr(synID(line('.'), 1, 1), 'name')\r")
+  call WaitForAssert({-> assert_match('^Comment', term_getline(buf, 6))})
+  call term_sendkeys(buf, "20%")
+  call term_sendkeys(buf, ":echo synIDattr(synID(line('.'), 5, 1), 'name')\r")
+  call WaitForAssert({-> assert_match('^Comment', term_getline(buf, 6))})
+
+  call StopVimInTerminal(buf)
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
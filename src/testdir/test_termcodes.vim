@@ -2001,7 +2001,11 @@ func Test_xx08_kitty_response()
         \ kitty: 'y',
         \ }, terminalprops())
 
-  set t_RV=
+  " kitty supports synchronized updates
+  call assert_equal("\<Esc>[?2026h", &t_BS)
+  call assert_equal("\<Esc>[?2026l", &t_ES)
+
+  set t_RV= t_BS= t_ES=
   call test_override('term_props', 0)
 endfunc
 
@@ -298,6 +298,45 @@ func Test_prop_find_smaller_len_than_match_col()
   call prop_type_delete('test')
 endfunc
 
+" Lines without text properties are skipped a data block at a time, check
+" that changes in a block that was skipped are noticed.
+func Test_prop_find_skip_lines()
+  new
+  call prop_type_add('test', {})
+  call setline(1, repeat(['some text'], 3000))
+  call prop_add(2000, 1, {'type': 'test', 'length': 4})
+  call assert_equal([2000], prop_list(1, {'end_lnum': -1})->map('v:val.lnum'))
+  call assert_equal(2000, prop_find({'type': 'test', 'lnum': 1, 'col': 1}).lnum)
+  call assert_equal(2000, prop_find({'type': 'test', 'lnum': 3000, 'col': 1}, 'b').lnum)
+  call assert_equal({}, prop_find({'type': 'test', 'lnum': 2001, 'col': 1}))
+
+  " add a property in a block without any
+  call prop_add(500, 1, {'type': 'test', 'length': 4})
+  call assert_equal(500, prop_find({'type': 'test', 'lnum': 1, 'col': 1}).lnum)
+  call assert_equal([500, 2000], prop_list(1, {'end_lnum': -1})->map('v:val.lnum'))
+
+  " a line with a property inserted by undo
+  let &undolevels = &undolevels
+  500delete
+  call assert_equal([1999], prop_list(1, {'end_lnum': -1})->map('v:val.lnum'))
+  undo
+  call assert_equal([500, 2000], prop_list(1, {'end_lnum': -1})->map('v:val.lnum'))
+
+  call assert_equal(2, prop_remove({'type': 'test', 'all': 1}))
+  call assert_equal([], prop_list(1, {'end_lnum': -1}))
+  call assert_equal({}, prop_find({'type': 'test', 'lnum': 1, 'col': 1}))
+
+  " a range beyond the last line
+  call prop_add(2000, 1, {'type': 'test', 'length': 4})
+  call assert_equal(1, prop_remove({'type': 'test'}, 1, 5000))
+  call prop_add(2000, 1, {'type': 'test', 'length': 4})
+  call prop_clear(1, 5000)
+  call assert_equal([], prop_list(1, {'end_lnum': -1}))
+
+  bwipe!
+  call prop_type_delete('test')
+endfunc
+
 func Test_prop_find_with_both_option_enabled()
   " Initialize
   new
@@ -974,6 +974,10 @@ f_test_getvalue(typval_T *argvars, typval_T *rettv)
 
     if (STRCMP(name, (char_u *)"need_fileinfo") == 0)
 	rettv->vval.v_number = need_fileinfo;
+#ifdef FEAT_SYN_HL
+    else if (STRCMP(name, (char_u *)"syn_last_state") == 0)
+	rettv->vval.v_number = syn_last_state_lnum(curwin);
+#endif
     else
 	semsg(_(e_invalid_argument_str), name);
 }
@@ -1082,7 +1082,9 @@ f_prop_clear(typval_T *argvars, typval_T *rettv UNUSED)
 	char_u *text;
 	size_t len;
 
-	if (lnum > buf->b_ml.ml_line_count)
+	// Skip over lines without text properties.
+	lnum = ml_find_textprop(buf, lnum, end);
+	if (lnum == 0 || lnum > buf->b_ml.ml_line_count)
 	    break;
 	text = ml_get_buf(buf, lnum, FALSE);
 	len = ml_get_buf_len(buf, lnum) + 1;
@@ -1214,15 +1216,23 @@ f_prop_find(typval_T *argvars, typval_T *rettv)
 
     while (1)
     {
-	char_u	*text = ml_get_buf(buf, lnum, FALSE);
-	size_t	textlen = ml_get_buf_len(buf, lnum) + 1;
-	int	count = (int)((buf->b_ml.ml_line_len - textlen)
-							 / sizeof(textprop_T));
+	char_u	*text;
+	size_t	textlen;
+	int	count;
 	int	    i;
 	textprop_T  prop;
 	int	    prop_start;
 	int	    prop_end;
 
+	// Skip over lines without text properties.
+	lnum = ml_find_textprop(buf, lnum,
+				 dir == FORWARD ? buf->b_ml.ml_line_count : 1);
+	if (lnum == 0)
+	    break;
+	text = ml_get_buf(buf, lnum, FALSE);
+	textlen = ml_get_buf_len(buf, lnum) + 1;
+	count = (int)((buf->b_ml.ml_line_len - textlen) / sizeof(textprop_T));
+
 	for (i = dir == BACKWARD ? count - 1 : 0; i >= 0 && i < count; i += dir)
 	{
 	    mch_memmove(&prop, text + textlen + i * sizeof(textprop_T),
@@ -1544,9 +1554,15 @@ f_prop_list(typval_T *argvars, typval_T *rettv)
 	emsg(_(e_invalid_range));
     else
 	for (lnum = start_lnum; lnum <= end_lnum; lnum++)
+	{
+	    // Skip over lines without text properties.
+	    lnum = ml_find_textprop(buf, lnum, end_lnum);
+	    if (lnum == 0)
+		break;
 	    get_props_in_line(buf, lnum, prop_types, prop_types_len,
 		    prop_ids, prop_ids_len,
 		    rettv->vval.v_list, add_lnum);
+	}
 
 errret:
     VIM_CLEAR(prop_types);
@@ -1671,7 +1687,9 @@ f_prop_remove(typval_T *argvars, typval_T *rettv)
     {
 	size_t len;
 
-	if (lnum > buf->b_ml.ml_line_count)
+	// Skip over lines without text properties.
+	lnum = ml_find_textprop(buf, lnum, end);
+	if (lnum == 0 || lnum > buf->b_ml.ml_line_count)
 	    break;
 	len = ml_get_buf_len(buf, lnum) + 1;
 	if ((size_t)buf->b_ml.ml_line_len > len)
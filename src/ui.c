@@ -378,6 +378,13 @@ inchar_loop(
 	    wait_time = 100L;
 #endif
 
+#ifdef FEAT_SYN_HL
+	// While waiting for the user to type compute syntax states ahead, a
+	// bit at a time, and check for a typed key in between.
+	if (wtime < 0 && wait_time != 0 && syntax_idle_parse())
+	    wait_time = 0L;
+#endif
+
 	// Wait for a character to be typed or another event, such as the winch
 	// signal or an event on the monitored file descriptors.
 	did_call_wait_func = TRUE;
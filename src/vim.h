@@ -624,6 +624,15 @@ extern int (*dyn_libintl_wputenv)(const wchar_t *envstring);
 #define UPD_NOT_VALID		40  // buffer needs complete redraw
 #define UPD_CLEAR		50  // screen messed up, clear it
 
+// phases of a screen update measured with ":drawtime"
+#define DRAWTIME_TEXT	0   // text of windows, win_update()
+#define DRAWTIME_SYNTAX	1   // syntax highlighting
+#define DRAWTIME_FOLDS	2   // updating folds
+#define DRAWTIME_STATUS	3   // status lines and tab pages line
+#define DRAWTIME_POPUPS	4   // popup menu and popup windows
+#define DRAWTIME_OUTPUT	5   // writing to the terminal
+#define DRAWTIME_COUNT	6
+
 // flags for screen_line()
 #define SLF_RIGHTLEFT	1
 #define SLF_POPUP	2
@@ -844,6 +853,7 @@ extern int (*dyn_libintl_wputenv)(const wchar_t *envstring);
 #define EXPAND_TERMINALOPT	57
 #define EXPAND_KEYMAP		58
 #define EXPAND_DIRS_IN_CDPATH	59
+#define EXPAND_DRAWTIME		60
 
 
 // Values for exmode_active (0 is no exmode)
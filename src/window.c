@@ -5834,6 +5834,10 @@ win_free(
 		ttp->tp_prevwin = NULL;
     }
     win_free_lsize(wp);
+    plines_cache_clear(wp);
+#ifdef FEAT_FOLDING
+    foldexpr_cache_clear(wp);
+#endif
 
     for (i = 0; i < wp->w_tagstacklen; ++i)
     {